@@ -10,7 +10,10 @@ public class FPP_Interaction : ModuleRules
             new string[]
             {
                 "Core",
-                "GeneralLibrary"
+                "GeneralLibrary",
+                "GameplayTags",
+                "AIModule",
+                "UMG"
             }
         );
 
@@ -19,6 +22,8 @@ public class FPP_Interaction : ModuleRules
             {
                 "CoreUObject",
                 "Engine",
+                "NetCore",
+                "GameplayTasks",
                 "Slate",
                 "SlateCore"
             }
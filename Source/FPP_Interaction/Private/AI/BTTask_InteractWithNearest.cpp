@@ -0,0 +1,57 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "AI/BTTask_InteractWithNearest.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "Components/FPP_InteractorComponent.h"
+#include "Components/FPP_InteractableComponent.h"
+
+UBTTask_InteractWithNearest::UBTTask_InteractWithNearest()
+{
+	NodeName = TEXT("Interact With Nearest");
+
+	TargetActorKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTTask_InteractWithNearest, TargetActorKey), AActor::StaticClass());
+	TargetActorKey.AllowNoneAsValue(true);
+}
+
+void UBTTask_InteractWithNearest::InitializeFromAsset(UBehaviorTree& Asset)
+{
+	Super::InitializeFromAsset(Asset);
+
+	if (const UBlackboardData* BlackboardAsset = GetBlackboardAsset())
+	{
+		TargetActorKey.ResolveSelectedKey(*BlackboardAsset);
+	}
+}
+
+EBTNodeResult::Type UBTTask_InteractWithNearest::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	const AAIController* Controller = OwnerComp.GetAIOwner();
+	const APawn* Pawn = Controller ? Controller->GetPawn() : nullptr;
+	UFPP_InteractorComponent* Interactor = Pawn ? Pawn->FindComponentByClass<UFPP_InteractorComponent>() : nullptr;
+	if (!Interactor)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	UFPP_InteractableComponent* Interactable = Interactor->FindInteractable(SearchRadius, RequiredTags);
+	if (!Interactable || !Interactor->InteractWith(Interactable))
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	if (TargetActorKey.IsSet())
+	{
+		if (UBlackboardComponent* Blackboard = OwnerComp.GetBlackboardComponent())
+		{
+			Blackboard->SetValueAsObject(TargetActorKey.SelectedKeyName, Interactable->GetOwner());
+		}
+	}
+	return EBTNodeResult::Succeeded;
+}
+
+FString UBTTask_InteractWithNearest::GetStaticDescription() const
+{
+	const FString Tags = RequiredTags.IsEmpty() ? TEXT("any") : RequiredTags.ToStringSimple();
+	return FString::Printf(TEXT("%s: radius %.0f, tags %s"), *Super::GetStaticDescription(), SearchRadius, *Tags);
+}
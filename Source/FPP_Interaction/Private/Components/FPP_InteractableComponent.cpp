@@ -3,6 +3,11 @@
 
 #include "Components/FPP_InteractableComponent.h"
 #include "FPP_Interaction.h"
+#include "GameFramework/Pawn.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Subsystems/InteractableRegistrySubsystem.h"
+#include "Subsystems/InteractionLatencySubsystem.h"
 
 // Sets default values for this component's properties
 UFPP_InteractableComponent::UFPP_InteractableComponent()
@@ -11,7 +16,19 @@ UFPP_InteractableComponent::UFPP_InteractableComponent()
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
 
-	// ...
+	// The state replicates if the owner does
+	SetIsReplicatedByDefault(true);
+}
+
+
+void UFPP_InteractableComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Push based, the state is only compared when it was marked dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UFPP_InteractableComponent, InteractableState, Params);
 }
 
 
@@ -20,35 +37,328 @@ void UFPP_InteractableComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
-	
+	// Interactables rarely change, their owner only replicates when the state does
+	AActor* Owner = GetOwner();
+	if (IsOwnerDormantByDefault() && Owner->HasAuthority() && Owner->GetIsReplicated() && Owner->NetDormancy == DORM_Awake)
+	{
+		Owner->SetNetDormancy(DORM_DormantAll);
+	}
+
+	if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+	{
+		RegisteredLocation = GetOwner()->GetActorLocation();
+
+		// Interactables saved with the cell data of their level are already in the index
+		if (CellEntryIndex != INDEX_NONE && Registry->LinkCell(GetOwner()->GetLevel(), this, CellEntryIndex))
+		{
+			bLinkedToCell = true;
+			return;
+		}
+
+		Registry->RegisterInteractable(this, RegisteredLocation);
+		bRegistered = true;
+	}
+}
+
+
+void UFPP_InteractableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// The cell data is unlinked with the level, only the interactables leaving before it are detached
+	if (bLinkedToCell)
+	{
+		if (EndPlayReason == EEndPlayReason::Destroyed)
+		{
+			if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+			{
+				Registry->DetachFromCell(GetOwner()->GetLevel(), CellEntryIndex);
+			}
+		}
+		bLinkedToCell = false;
+	}
+
+	if (bRegistered)
+	{
+		if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+		{
+			Registry->UnregisterInteractable(this, RegisteredLocation);
+		}
+		bRegistered = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+
+void UFPP_InteractableComponent::UpdateRegisteredLocation()
+{
+	if (!bRegistered && !bLinkedToCell)
+	{
+		return;
+	}
+
+	if (UInteractableRegistrySubsystem* Registry = GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>())
+	{
+		// The cell data is immutable, an interactable that moves is registered alone from now on
+		if (bLinkedToCell)
+		{
+			Registry->DetachFromCell(GetOwner()->GetLevel(), CellEntryIndex);
+			bLinkedToCell = false;
+
+			RegisteredLocation = GetOwner()->GetActorLocation();
+			Registry->RegisterInteractable(this, RegisteredLocation);
+			bRegistered = true;
+			return;
+		}
+
+		const FVector NewLocation = GetOwner()->GetActorLocation();
+		Registry->MoveInteractable(this, RegisteredLocation, NewLocation);
+		RegisteredLocation = NewLocation;
+	}
 }
 
 
 /**
  * Updates the focus state of the interactable component.
+ * The highlight and the prompt are shown by the UInteractionPresentationSubsystem of the local player,
+ * so the interactable doesn't own any UI object. The change is posted to the interaction event bus.
  *
  * @param bFocused A boolean value indicating whether the component is in focus (true)
- *                 or out of focus (false). When true, the component should display visual
- *                 or contextual cues indicating focus. Otherwise, it should hide those cues.
+ *                 or out of focus (false).
  */
 void UFPP_InteractableComponent::InFocus(const bool bFocused)
 {
-	if (bFocused)
+	if (bActivateDebugLogs){UE_LOG(LogFPP_Interaction, Log, TEXT("%s focus: %d. %s"), *GetNameSafe(GetOwner()), bFocused, *FPPINTERACTION_LOGS_LINE)}
+
+	FInteractionEvent Event;
+	Event.Type = bFocused ? EInteractionEventType::FocusGained : EInteractionEventType::FocusLost;
+	PostEvent(MoveTemp(Event));
+}
+
+
+void UFPP_InteractableComponent::PostEvent(FInteractionEvent&& Event)
+{
+	Event.Interactable = this;
+	if (InteractionConfig)
+	{
+		Event.Tags = InteractionConfig->InteractionTags;
+	}
+
+	if (UInteractionEventSubsystem* EventBus = GetWorld() ? GetWorld()->GetSubsystem<UInteractionEventSubsystem>() : nullptr)
 	{
-		if (bActivateDebugLogs){UE_LOG(LogFPP_Interaction, Log, TEXT("TODO: Add widget calls to show focus. %s"), *FPPINTERACTION_LOGS_LINE)}
+		EventBus->PostEvent(MoveTemp(Event));
 	}
 	else
 	{
-		if (bActivateDebugLogs){UE_LOG(LogFPP_Interaction, Log, TEXT("TODO: Add widget calls to remove focus.. %s"), *FPPINTERACTION_LOGS_LINE)}
+		DeliverEvent(Event);
+	}
+}
+
+
+void UFPP_InteractableComponent::DeliverEvent(const FInteractionEvent& Event)
+{
+	switch (Event.Type)
+	{
+	case EInteractionEventType::FocusGained:
+		OnFocus.Broadcast(true);
+		break;
+	case EInteractionEventType::FocusLost:
+		OnFocus.Broadcast(false);
+		break;
+	case EInteractionEventType::Interacted:
+		BpInteracted(Event.Hit, Event.Interactor.Get(), Event.InputAction.Get());
+		if (Event.InputSeconds > 0.0)
+		{
+			if (UInteractionLatencySubsystem* Latency = GetWorld()->GetSubsystem<UInteractionLatencySubsystem>())
+			{
+				Latency->Record(EInteractionLatency::InputToEffect, GetOwner()->GetClass(), FPlatformTime::Seconds() - Event.InputSeconds);
+			}
+		}
+		if (Event.PredictionKey != 0)
+		{
+			RecordPredictionEffect(Event);
+		}
+		break;
 	}
+}
 
-	OnFocus.Broadcast(bFocused);
+
+UPrimitiveComponent* UFPP_InteractableComponent::GetHighlightPrimitive(const FHitResult& FocusHit) const
+{
+	if (!HighlightComponentTag.IsNone())
+	{
+		if (UPrimitiveComponent* Primitive = GetOwner()->FindComponentByTag<UPrimitiveComponent>(HighlightComponentTag))
+		{
+			return Primitive;
+		}
+	}
+	return FocusHit.GetComponent();
 }
 
-void UFPP_InteractableComponent::Interact(FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent,
+bool UFPP_InteractableComponent::Interact(FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent,
 	const UInputAction* InputAction)
 {
-	BpInteracted(HitResult, InteractorComponent, InputAction);
+	if (InteractableState == EInteractableState::Disabled || GetCooldownRemaining() > 0.0f)
+	{
+		if (bActivateDebugLogs){UE_LOG(LogFPP_Interaction, Log, TEXT("%s can't be used now. %s"), *GetNameSafe(GetOwner()), *FPPINTERACTION_LOGS_LINE)}
+		return false;
+	}
+
+	if (InteractionConfig && InteractionConfig->CooldownTime > 0.0f)
+	{
+		CooldownEndTime = GetWorld()->GetTimeSeconds() + InteractionConfig->CooldownTime;
+	}
+
+	FInteractionEvent Event;
+	Event.Type = EInteractionEventType::Interacted;
+	Event.Interactor = InteractorComponent;
+	Event.InputAction = InputAction;
+	Event.InputSeconds = InteractorComponent ? InteractorComponent->GetInteractionInputSeconds() : 0.0;
+	Event.PredictionKey = InteractorComponent ? InteractorComponent->GetInteractionPredictionKey() : 0;
+	Event.Hit = MoveTemp(HitResult);
+	PostEvent(MoveTemp(Event));
+	return true;
+}
+
+
+FInteractableStateSnapshot UFPP_InteractableComponent::GetSnapshot() const
+{
+	FInteractableStateSnapshot Snapshot;
+	Snapshot.State = InteractableState;
+	Snapshot.CooldownRemaining = GetCooldownRemaining();
+	return Snapshot;
+}
+
+
+void UFPP_InteractableComponent::ApplySnapshot(const FInteractableStateSnapshot& Snapshot)
+{
+	CooldownEndTime = Snapshot.CooldownRemaining > 0.0f ? GetWorld()->GetTimeSeconds() + Snapshot.CooldownRemaining : 0.0f;
+	SetInteractableState(Snapshot.State);
+}
+
+
+void UFPP_InteractableComponent::BeginPrediction(uint16 PredictionKey)
+{
+	FPendingPrediction& Prediction = PendingPredictions.AddDefaulted_GetRef();
+	Prediction.Key = PredictionKey;
+	Prediction.PreviousState = GetSnapshot();
+}
+
+
+void UFPP_InteractableComponent::ResolvePrediction(uint16 PredictionKey, bool bAccepted, const FInteractableStateSnapshot& AuthoritativeState)
+{
+	const int32 Index = PendingPredictions.IndexOfByPredicate([PredictionKey](const FPendingPrediction& Prediction) { return Prediction.Key == PredictionKey; });
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (bAccepted)
+	{
+		PendingPredictions.RemoveAt(Index);
+
+		// The server is authoritative, once nothing else is predicted its state is the one kept
+		if (PendingPredictions.IsEmpty())
+		{
+			ApplySnapshot(AuthoritativeState);
+		}
+		return;
+	}
+
+	// The later predictions were made from the rejected state, they are dropped with it
+	if (bActivateDebugLogs){UE_LOG(LogFPP_Interaction, Log, TEXT("Interaction with %s rejected by the server, rolling back. %s"), *GetNameSafe(GetOwner()), *FPPINTERACTION_LOGS_LINE)}
+	const FInteractableStateSnapshot PreviousState = PendingPredictions[Index].PreviousState;
+	PendingPredictions.RemoveAt(Index, PendingPredictions.Num() - Index);
+	ApplySnapshot(PendingPredictions.IsEmpty() ? AuthoritativeState : PreviousState);
+}
+
+
+bool UFPP_InteractableComponent::CanOwnerBeDormant(const AActor* Actor)
+{
+	return Actor && !Actor->IsA<APawn>() && !Actor->IsReplicatingMovement();
+}
+
+
+bool UFPP_InteractableComponent::IsOwnerDormantByDefault() const
+{
+	return bDormantByDefault && CanOwnerBeDormant(GetOwner());
+}
+
+
+void UFPP_InteractableComponent::RecordPredictionEffect(const FInteractionEvent& Event)
+{
+	// The server answers with the state the interaction led to, the client records it to re-apply it
+	if (GetOwner()->HasAuthority())
+	{
+		if (UFPP_InteractorComponent* Interactor = Event.Interactor.Get())
+		{
+			Interactor->SendInteractResult(this, Event.PredictionKey);
+		}
+		return;
+	}
+
+	FPendingPrediction* Prediction = PendingPredictions.FindByPredicate([&Event](const FPendingPrediction& Pending) { return Pending.Key == Event.PredictionKey; });
+	if (Prediction)
+	{
+		Prediction->PredictedState = GetSnapshot();
+		Prediction->bHasPredictedState = true;
+	}
+}
+
+
+void UFPP_InteractableComponent::OnRep_InteractableState(EInteractableState PreviousState)
+{
+	// The replicated state is authoritative, the pending predictions made from it are applied on top again
+	EInteractableState State = InteractableState;
+	for (const FPendingPrediction& Prediction : PendingPredictions)
+	{
+		if (Prediction.bHasPredictedState && Prediction.PreviousState.State == State)
+		{
+			State = Prediction.PredictedState.State;
+		}
+	}
+	InteractableState = State;
+
+	if (!HasPendingPredictions() || State != PreviousState)
+	{
+		OnStateChanged.Broadcast(State);
+	}
+}
+
+
+void UFPP_InteractableComponent::SetInteractableState(EInteractableState NewState)
+{
+	if (InteractableState != NewState)
+	{
+		InteractableState = NewState;
+		MarkStateDirty();
+		OnStateChanged.Broadcast(NewState);
+	}
+}
+
+
+void UFPP_InteractableComponent::MarkStateDirty()
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME(UFPP_InteractableComponent, InteractableState, this);
+
+	AActor* Owner = GetOwner();
+	if (Owner && Owner->HasAuthority())
+	{
+		Owner->FlushNetDormancy();
+	}
+}
+
+
+float UFPP_InteractableComponent::GetCooldownRemaining() const
+{
+	const UWorld* World = GetWorld();
+	return World ? FMath::Max(0.0f, CooldownEndTime - World->GetTimeSeconds()) : 0.0f;
+}
+
+
+void UFPP_InteractableComponent::RestoreState(EInteractableState SavedState, float CooldownRemaining)
+{
+	InteractableState = SavedState;
+	MarkStateDirty();
+	CooldownEndTime = CooldownRemaining > 0.0f ? GetWorld()->GetTimeSeconds() + CooldownRemaining : 0.0f;
 }
 
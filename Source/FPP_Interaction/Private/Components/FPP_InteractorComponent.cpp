@@ -6,10 +6,29 @@
 #include "Camera/CameraComponent.h"
 #include "FPP_Interaction.h"
 #include "GeneralLibrary/Public/UtilsLib.h"
+#include "GameplayPerfTracker.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
+#include "InputMappingContext.h"
 #include "GameFramework/Character.h"
 #include "Components/FPP_InteractableComponent.h"
+#include "Subsystems/InteractableRegistrySubsystem.h"
+#include "Subsystems/InteractionPresentationSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Controller.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+// Heap traffic of the focus detection, expected to stay flat once the hit array is warmed up
+LLM_DEFINE_TAG(InteractionDetection);
+
+namespace InteractionLatency
+{
+	// Inputs older than this when the focus is acquired were not waiting for it
+	static constexpr double InputToFocusWindowSeconds = 1.0;
+}
 
 
 
@@ -20,7 +39,9 @@ UFPP_InteractorComponent::UFPP_InteractorComponent()
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
-	// ...
+
+	// Replicated for the interaction RPCs
+	SetIsReplicatedByDefault(true);
 }
 
 
@@ -39,7 +60,26 @@ void UFPP_InteractorComponent::BeginPlay()
 		UE_LOG(LogTemp, Warning, TEXT("UFPP_InteractorComponent: OwningPawn not found!"));
 		return;
 	}
-	BindInputActions();
+	OwningPawn->ReceiveControllerChangedDelegate.AddDynamic(this, &UFPP_InteractorComponent::HandleControllerChanged);
+
+	// The AI don't use the inputs, they interact through InteractWith
+	if (ResolvedMode == EInteractorMode::Player)
+	{
+		BindInputActions();
+	}
+}
+
+
+void UFPP_InteractorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (OwningPawn)
+	{
+		OwningPawn->ReceiveControllerChangedDelegate.RemoveDynamic(this, &UFPP_InteractorComponent::HandleControllerChanged);
+	}
+	ToggleFocusDetection(false);
+	UpdateInputMapping(nullptr);
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
@@ -92,7 +132,8 @@ void UFPP_InteractorComponent::ToggleFocusDetection(bool activate)
 		return;
 	}
 	
-	if (activate)
+	// The AI query the interactables on demand, they don't need the periodic detection
+	if (activate && ResolvedMode != EInteractorMode::AI)
 	{
 		if (GetWorld() == nullptr || !GetWorld()->IsGameWorld())
 		{
@@ -154,6 +195,13 @@ void UFPP_InteractorComponent::BindInputActions()
 		return;
 	}
 
+	// Already bound, e.g. the controller changed but the input component was kept
+	if (EnhancedInput == BoundInputComponent.Get())
+	{
+		return;
+	}
+	BoundInputComponent = EnhancedInput;
+
 	for (TObjectPtr<UInputAction> InputAction : InteractionActions)
 	{
 		if (InputAction)
@@ -185,6 +233,16 @@ void UFPP_InteractorComponent::HandleTriggerInputAction(const FInputActionInstan
 		UE_LOG(LogFPP_Interaction, Log, TEXT("InputAction triggered in UFPP_InteractorComponent!"));
 	}
 	
+	// Checked with or without InteractionMappingContext: without it the game maps every interaction action,
+	// with it a context of the game may still map them, in both cases only the one required by the focus interacts
+	const UFPP_InteractableComponent* Focused = HasInteractableComponent(FocusedHit.GetActor());
+	if (Focused && Focused->InteractionConfig && Focused->InteractionConfig->RequiredInputAction
+		&& Focused->InteractionConfig->RequiredInputAction != instance.GetSourceAction())
+	{
+		return;
+	}
+
+	const double InputSeconds = FPlatformTime::Seconds();
 	if (CanInteract(FocusedHit))
 	{
 		if (bActivateDebugLogs)
@@ -194,17 +252,175 @@ void UFPP_InteractorComponent::HandleTriggerInputAction(const FInputActionInstan
 		
 		if (UFPP_InteractableComponent* InteractableComponent = HasInteractableComponent(FocusedHit.GetActor()))
 		{
-			InteractableComponent->Interact(FocusedHit, this, instance.GetSourceAction());
+			RecordLatency(EInteractionLatency::FocusAge, FocusedHit.GetActor(), InputSeconds - FocusConfirmedSeconds);
+
+			InteractionInputSeconds = InputSeconds;
+			RequestInteract(InteractableComponent, FocusedHit, instance.GetSourceAction());
+			InteractionInputSeconds = 0.0;
+			return;
 		}
 	}
+
+	// Measured when the detection focuses something, in case the player was waiting for it
+	UnfocusedInputSeconds = InputSeconds;
 }
 
+
+void UFPP_InteractorComponent::RecordLatency(EInteractionLatency Latency, const AActor* Interactable, double Seconds) const
+{
+	if (!UInteractionLatencySubsystem::IsEnabled() || !Interactable)
+	{
+		return;
+	}
+
+	if (UInteractionLatencySubsystem* LatencySubsystem = GetWorld()->GetSubsystem<UInteractionLatencySubsystem>())
+	{
+		LatencySubsystem->Record(Latency, Interactable->GetClass(), Seconds);
+	}
+}
+
+/**
+ * Interacts right away with authority. On a client, the interaction is applied locally with a prediction key
+ * so the player sees it without waiting for the server, and the server answers with its state.
+ * Interactables without prediction wait for the server and its replicated state, the key of their interaction
+ * is only used to measure the input to effect latency when the server answers.
+ */
+bool UFPP_InteractorComponent::RequestInteract(UFPP_InteractableComponent* Interactable, const FHitResult& HitResult, const UInputAction* InputAction)
+{
+	if (!Interactable)
+	{
+		return false;
+	}
+
+	if (GetOwner()->HasAuthority())
+	{
+		return Interactable->Interact(HitResult, this, InputAction);
+	}
+
+	const uint16 PredictionKey = ++LastPredictionKey == 0 ? ++LastPredictionKey : LastPredictionKey;
+	if (Interactable->bPredictInteractions)
+	{
+		// Recorded before interacting, so a rejection restores the state the player saw
+		Interactable->BeginPrediction(PredictionKey);
+		TGuardValue<uint16> KeyGuard(InteractionPredictionKey, PredictionKey);
+		if (!Interactable->Interact(HitResult, this, InputAction))
+		{
+			Interactable->ResolvePrediction(PredictionKey, false, Interactable->GetSnapshot());
+			return false;
+		}
+	}
+	else if (InteractionInputSeconds > 0.0)
+	{
+		// The effect is only seen when the server answers, the oldest inputs are dropped if it never does
+		if (AwaitedInputs.Num() >= MaxAwaitedInputs)
+		{
+			AwaitedInputs.RemoveAt(0);
+		}
+		AwaitedInputs.Add({ PredictionKey, InteractionInputSeconds });
+	}
+
+	ServerInteract(Interactable, InputAction, PredictionKey);
+	return true;
+}
+
+
+void UFPP_InteractorComponent::ServerInteract_Implementation(UFPP_InteractableComponent* Interactable, const UInputAction* InputAction, uint16 PredictionKey)
+{
+	bool bAccepted = false;
+	if (Interactable && OwningPawn)
+	{
+		// The server checks the distance itself, with some margin for the movement during the round trip
+		AActor* Target = Interactable->GetOwner();
+		const float MaxDistance = (DetectionDistance + DetectionSensibility) * 1.5f + Target->GetSimpleCollisionRadius();
+		if (FVector::DistSquared(OwningPawn->GetActorLocation(), Target->GetActorLocation()) <= FMath::Square(MaxDistance))
+		{
+			FHitResult Hit(Target, nullptr, Target->GetActorLocation(), (OwningPawn->GetActorLocation() - Target->GetActorLocation()).GetSafeNormal());
+			Hit.bBlockingHit = true;
+			TGuardValue<uint16> KeyGuard(InteractionPredictionKey, PredictionKey);
+			bAccepted = Interactable->Interact(Hit, this, InputAction);
+		}
+	}
+
+	// An accepted interaction is answered when its event is delivered, with the state it leads to
+	if (PredictionKey != 0 && Interactable && !bAccepted)
+	{
+		ClientInteractResult(Interactable, PredictionKey, false, Interactable->GetSnapshot());
+	}
+}
+
+
+void UFPP_InteractorComponent::SendInteractResult(UFPP_InteractableComponent* Interactable, uint16 PredictionKey)
+{
+	if (Interactable && PredictionKey != 0)
+	{
+		ClientInteractResult(Interactable, PredictionKey, true, Interactable->GetSnapshot());
+	}
+}
+
+
+void UFPP_InteractorComponent::ClientInteractResult_Implementation(UFPP_InteractableComponent* Interactable, uint16 PredictionKey, bool bAccepted, FInteractableStateSnapshot AuthoritativeState)
+{
+	const int32 InputIndex = AwaitedInputs.IndexOfByPredicate([PredictionKey](const TPair<uint16, double>& Input) { return Input.Key == PredictionKey; });
+	if (InputIndex != INDEX_NONE)
+	{
+		if (bAccepted && Interactable)
+		{
+			RecordLatency(EInteractionLatency::InputToEffect, Interactable->GetOwner(), FPlatformTime::Seconds() - AwaitedInputs[InputIndex].Value);
+		}
+		AwaitedInputs.RemoveAt(InputIndex);
+	}
+
+	if (Interactable)
+	{
+		Interactable->ResolvePrediction(PredictionKey, bAccepted, AuthoritativeState);
+	}
+}
+
+
 void UFPP_InteractorComponent::HandleStopInputAction(const FInputActionInstance& instance)
 {
+	if (HoldProgress > 0.0f)
+	{
+		HoldProgress = 0.0f;
+		PublishFocusSnapshot();
+	}
 }
 
 void UFPP_InteractorComponent::HandleOnGoingInputAction(const FInputActionInstance& instance)
 {
+	const UFPP_InteractableComponent* Focused = HasInteractableComponent(FocusedHit.GetActor());
+	const UInteractionConfig* Config = Focused ? Focused->InteractionConfig : nullptr;
+	if (!Config || Config->InputType != EInputType::Hold || Config->HoldDuration <= 0.0f)
+	{
+		return;
+	}
+
+	HoldProgress = FMath::Clamp(instance.GetElapsedTime() / Config->HoldDuration, 0.0f, 1.0f);
+	PublishFocusSnapshot();
+}
+
+
+/**
+ * Publishes the focus for the other threads. Called when the focus or the hold progress change,
+ * the cost is a copy of a few words to the sequence lock.
+ */
+void UFPP_InteractorComponent::PublishFocusSnapshot()
+{
+	FInteractionFocusSnapshot Snapshot;
+	if (AActor* FocusedActor = FocusedHit.GetActor())
+	{
+		Snapshot.FocusedActor = FocusedActor;
+		Snapshot.ImpactPoint = FocusedHit.ImpactPoint;
+		Snapshot.HoldProgress = HoldProgress;
+		Snapshot.bHasFocus = true;
+
+		const UFPP_InteractableComponent* Focused = HasInteractableComponent(FocusedActor);
+		if (Focused && Focused->InteractionConfig && !Focused->InteractionConfig->InteractionTags.IsEmpty())
+		{
+			Snapshot.InteractionType = Focused->InteractionConfig->InteractionTags.First();
+		}
+	}
+	FocusSnapshot.Write(Snapshot);
 }
 
 
@@ -238,6 +454,18 @@ void UFPP_InteractorComponent::Initialize()
 	// Get a reference to the owning Pawn
 	OwningPawn = Cast<APawn>(GetOwner());
 
+	ResolvedMode = ResolveMode();
+	if (ResolvedMode == EInteractorMode::AI)
+	{
+		// The component may have been activated before the mode was known
+		ToggleFocusDetection(false);
+		if (bActivateDebugLogs)
+		{
+			UE_LOG(LogFPP_Interaction, Log, TEXT("Interactor of %s set to AI mode. %s"), *GetNameSafe(OwningPawn), *FPPINTERACTION_LOGS_LINE);
+		}
+		return;
+	}
+
 	// Check if the owner is controlled by a player
 	if (OwningPawn && OwningPawn->IsPlayerControlled())
 	{
@@ -256,12 +484,150 @@ void UFPP_InteractorComponent::Initialize()
 }
 
 
+/**
+ * Resolves the mode of the interactor. In Auto, a pawn possessed by a non player controller is an AI,
+ * any other pawn keeps the player behaviour.
+ * @return The mode to use, Player or AI.
+ */
+EInteractorMode UFPP_InteractorComponent::ResolveMode() const
+{
+	if (InteractorMode != EInteractorMode::Auto)
+	{
+		return InteractorMode;
+	}
+
+	const AController* Controller = OwningPawn ? OwningPawn->GetController() : nullptr;
+	return Controller && !Controller->IsPlayerController() ? EInteractorMode::AI : EInteractorMode::Player;
+}
+
+
+void UFPP_InteractorComponent::HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	const EInteractorMode NewMode = ResolveMode();
+	if (NewMode == ResolvedMode)
+	{
+		return;
+	}
+
+	ResolvedMode = NewMode;
+	if (ResolvedMode == EInteractorMode::AI)
+	{
+		ToggleFocusDetection(false);
+		ClearFocusedObject();
+	}
+	else
+	{
+		PlayerCamera = OwningPawn->FindComponentByClass<UCameraComponent>();
+		if (IsActive())
+		{
+			ToggleFocusDetection(true);
+		}
+
+		// The player controller creates the input component of the pawn when it restarts it, after the controller change
+		GetWorld()->GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateWeakLambda(this, [this]()
+		{
+			if (ResolvedMode == EInteractorMode::Player && OwningPawn && OwningPawn->IsLocallyControlled())
+			{
+				BindInputActions();
+			}
+		}));
+	}
+}
+
+
+/**
+ * Finds the closest interactable in the registry and focuses it if the owner can see it.
+ * Only the chosen interactable is traced, so the cost does not depend on the number of interactables around.
+ * @param Radius Maximum distance of the interactable from the owner.
+ * @param RequiredTags Tags the interaction config of the interactable must have.
+ * @return The interactable focused, or nullptr if none is found or visible.
+ */
+UFPP_InteractableComponent* UFPP_InteractorComponent::FindInteractable(float Radius, FGameplayTagContainer RequiredTags)
+{
+	GENLIB_PERF_SCOPE("FindInteractable");
+
+	const UInteractableRegistrySubsystem* Registry = GetWorld() ? GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>() : nullptr;
+	if (!Registry || !OwningPawn)
+	{
+		return nullptr;
+	}
+
+	UFPP_InteractableComponent* Interactable = Registry->FindNearestInteractable(OwningPawn->GetActorLocation(), Radius, RequiredTags, OwningPawn);
+	if (!Interactable)
+	{
+		ClearFocusedObject();
+		return nullptr;
+	}
+
+	// Line of sight from the eyes of the owner to the interactable
+	AActor* Target = Interactable->GetOwner();
+	FVector EyesLocation;
+	FRotator EyesRotation;
+	OwningPawn->GetActorEyesViewPoint(EyesLocation, EyesRotation);
+	const FVector TargetLocation = Target->GetActorLocation();
+
+	FHitResult Hit;
+	const FCollisionQueryParams Params(SCENE_QUERY_STAT(InteractorLineOfSight), false, OwningPawn);
+	if (GetWorld()->LineTraceSingleByChannel(Hit, EyesLocation, TargetLocation, DetectionChannel, Params))
+	{
+		if (Hit.GetActor() != Target)
+		{
+			if (bActivateDebugLogs)
+			{
+				UE_LOG(LogFPP_Interaction, Log, TEXT("%s is not visible, blocked by %s. %s"), *Target->GetName(), *GetNameSafe(Hit.GetActor()), *FPPINTERACTION_LOGS_LINE);
+			}
+			ClearFocusedObject();
+			return nullptr;
+		}
+	}
+	else
+	{
+		// Nothing blocks the trace on the detection channel, the hit is built on the target
+		Hit = FHitResult(Target, nullptr, TargetLocation, (EyesLocation - TargetLocation).GetSafeNormal());
+		Hit.bBlockingHit = true;
+		Hit.TraceStart = EyesLocation;
+		Hit.TraceEnd = TargetLocation;
+	}
+
+	const bool bFocusChanged = Target != FocusedHit.GetActor();
+	if (bFocusChanged)
+	{
+		ClearFocusedObject();
+		Interactable->InFocus(true);
+	}
+	FocusedHit = Hit;
+	if (bFocusChanged)
+	{
+		PublishFocusSnapshot();
+	}
+	return Interactable;
+}
+
+
+/**
+ * Interacts with the focused interactable using the input action required by its config.
+ * @param Interactable The interactable, it has to be the one focused.
+ * @return True if the interaction happened.
+ */
+bool UFPP_InteractorComponent::InteractWith(UFPP_InteractableComponent* Interactable)
+{
+	if (!Interactable || Interactable->GetOwner() != FocusedHit.GetActor() || !CanInteract(FocusedHit))
+	{
+		return false;
+	}
+
+	const UInputAction* InputAction = Interactable->InteractionConfig ? Interactable->InteractionConfig->RequiredInputAction : nullptr;
+	return RequestInteract(Interactable, FocusedHit, InputAction);
+}
+
+
 /**
  * Updates the detected objects from a list of hit results, identifies interactable components,
  * and sets focus on a new interactable object if it is not already focused.
+ * The first hit with an interactable is focused, the hits are ranked by the view cone if it ran.
  * @param HitResults An array of hit results derived from object detection traces.
  */
-void UFPP_InteractorComponent::UpdateDetectedObject(TArray<FHitResult> HitResults)
+void UFPP_InteractorComponent::UpdateDetectedObject(const TArray<FHitResult>& HitResults)
 {
 	for (const FHitResult& HitResult : HitResults)
 	{
@@ -279,12 +645,30 @@ void UFPP_InteractorComponent::UpdateDetectedObject(TArray<FHitResult> HitResult
 			continue; // Skip if no interactable component is found
 		}
 
+		FocusConfirmedSeconds = FPlatformTime::Seconds();
 		if (Actor != FocusedHit.GetActor())
 		{
-			ClearFocusedObject();
+			// The mapping is swapped below, removing it in between would rebuild the mappings twice
+			ClearFocusedObject(false);
 			Component->InFocus(true);
 			FocusedHit = HitResult;
+
+			// Only the inputs recent enough to have been meant for this interactable
+			if (UnfocusedInputSeconds > 0.0 && FocusConfirmedSeconds - UnfocusedInputSeconds <= InteractionLatency::InputToFocusWindowSeconds)
+			{
+				RecordLatency(EInteractionLatency::InputToFocus, Actor, FocusConfirmedSeconds - UnfocusedInputSeconds);
+			}
+			UnfocusedInputSeconds = 0.0;
+
+			if (UInteractionPresentationSubsystem* Presentation = GetPresentationSubsystem())
+			{
+				Presentation->SetFocus(Component, Component->GetHighlightPrimitive(HitResult));
+				FocusPresentation = Presentation;
+			}
+			UpdateInputMapping(Component);
+			PublishFocusSnapshot();
 		}
+		break;
 	}	
 }
 
@@ -293,13 +677,120 @@ void UFPP_InteractorComponent::UpdateDetectedObject(TArray<FHitResult> HitResult
  * Clears the currently focused object by resetting the focus state of its interactable component, if any.
  * This method ensures the interactable component is notified of losing focus before clearing the stored hit result.
  */
-void UFPP_InteractorComponent::ClearFocusedObject()
+void UFPP_InteractorComponent::ClearFocusedObject(bool bRemoveInputMapping)
 {
 	if (UFPP_InteractableComponent* Component = HasInteractableComponent(FocusedHit.GetActor()))
 	{
 		Component->InFocus(false);
 	}
+
+	// The subsystem that showed the focus, the owner may not be controlled by its player anymore
+	if (UInteractionPresentationSubsystem* Presentation = FocusPresentation.Get())
+	{
+		Presentation->ClearFocus();
+		FocusPresentation.Reset();
+	}
+	if (bRemoveInputMapping)
+	{
+		UpdateInputMapping(nullptr);
+	}
+
+	const bool bHadFocus = FocusedHit.GetActor() != nullptr;
 	FocusedHit.Reset();
+	HoldProgress = 0.0f;
+	if (bHadFocus)
+	{
+		PublishFocusSnapshot();
+	}
+}
+
+
+/**
+ * Returns the presentation subsystem of the local player controlling the owner.
+ * The AI and the pawns of remote players have none, their focus is not shown.
+ */
+UInteractionPresentationSubsystem* UFPP_InteractorComponent::GetPresentationSubsystem() const
+{
+	if (ResolvedMode != EInteractorMode::Player || !OwningPawn || !OwningPawn->IsLocallyControlled())
+	{
+		return nullptr;
+	}
+
+	const APlayerController* PlayerController = Cast<APlayerController>(OwningPawn->GetController());
+	return PlayerController ? ULocalPlayer::GetSubsystem<UInteractionPresentationSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+}
+
+
+/**
+ * Enhanced Input only evaluates the triggers of the mapped actions, so the interaction keys cost nothing
+ * while nothing is focused. The context of the focused interactable only maps its required input action.
+ */
+void UFPP_InteractorComponent::UpdateInputMapping(const UFPP_InteractableComponent* Focused)
+{
+	if (!InteractionMappingContext)
+	{
+		return;
+	}
+
+	UInputMappingContext* NewContext = nullptr;
+	UEnhancedInputLocalPlayerSubsystem* InputSubsystem = MappedInputSubsystem.Get();
+	if (Focused)
+	{
+		const bool bLocalPlayer = ResolvedMode == EInteractorMode::Player && OwningPawn && OwningPawn->IsLocallyControlled();
+		const APlayerController* PlayerController = bLocalPlayer ? Cast<APlayerController>(OwningPawn->GetController()) : nullptr;
+		InputSubsystem = PlayerController ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+		if (InputSubsystem)
+		{
+			NewContext = GetFilteredMappingContext(Focused->InteractionConfig ? Focused->InteractionConfig->RequiredInputAction : nullptr);
+		}
+	}
+
+	if (NewContext == ActiveMappingContext && InputSubsystem == MappedInputSubsystem.Get())
+	{
+		return;
+	}
+
+	// Both changes are applied by the same deferred rebuild, and the keys held during a focus switch keep working
+	FModifyContextOptions Options;
+	Options.bIgnoreAllPressedKeysUntilRelease = false;
+
+	// The previous local player may not control the owner anymore
+	if (UEnhancedInputLocalPlayerSubsystem* PreviousSubsystem = MappedInputSubsystem.Get(); PreviousSubsystem && ActiveMappingContext)
+	{
+		PreviousSubsystem->RemoveMappingContext(ActiveMappingContext, Options);
+	}
+
+	ActiveMappingContext = NewContext;
+	MappedInputSubsystem = NewContext ? InputSubsystem : nullptr;
+	if (NewContext)
+	{
+		InputSubsystem->AddMappingContext(NewContext, InteractionMappingPriority, Options);
+	}
+}
+
+
+UInputMappingContext* UFPP_InteractorComponent::GetFilteredMappingContext(const UInputAction* InputAction)
+{
+	if (!InputAction)
+	{
+		return InteractionMappingContext;
+	}
+
+	if (const TObjectPtr<UInputMappingContext>* Context = FilteredMappingContexts.Find(InputAction))
+	{
+		return *Context;
+	}
+
+	UInputMappingContext* Context = NewObject<UInputMappingContext>(this);
+	for (const FEnhancedActionKeyMapping& Mapping : InteractionMappingContext->GetMappings())
+	{
+		if (Mapping.Action == InputAction)
+		{
+			Context->MapKey(InputAction, Mapping.Key) = Mapping;
+		}
+	}
+	FilteredMappingContexts.Add(InputAction, Context);
+	return Context;
 }
 
 
@@ -310,12 +801,16 @@ void UFPP_InteractorComponent::ClearFocusedObject()
  */
 void UFPP_InteractorComponent::FocusDetection()
 {
+	GENLIB_PERF_SCOPE("FocusDetection");
+	LLM_SCOPE_BYTAG(InteractionDetection);
+
 	if (bActivateDebugLogs)
 	{
 		UE_LOG(LogFPP_Interaction, Log, TEXT("FocusDetection function called. %s"), *FPPINTERACTION_LOGS_LINE);	
 	}
-	//Tracing from the Camara of the player.
-	TArray<FHitResult> HitResults;
+	//Tracing from the Camara of the player. The hit array is reused, its capacity survives between detections
+	TArray<FHitResult>& HitResults = DetectionHits;
+	HitResults.Reset();
 	bool bIsFocusing = UUtilsLib::TraceFromActor(
 		OwningPawn,
 		ETraceType::Sphere,
@@ -331,6 +826,25 @@ void UFPP_InteractorComponent::FocusDetection()
 
 	if (bIsFocusing)
 	{
+		// The hits of the most centered interactables first, the others keep their order after them.
+		// The registry is only queried to choose between several hits, it never decides if something is focused
+		ViewConeCandidates.Reset();
+		const UInteractableRegistrySubsystem* Registry = bPrefilterWithViewCone && PlayerCamera && HitResults.Num() > 1 ? GetWorld()->GetSubsystem<UInteractableRegistrySubsystem>() : nullptr;
+		if (Registry)
+		{
+			const FViewCone Cone(PlayerCamera->GetComponentLocation() + StartOffset, PlayerCamera->GetForwardVector(), ViewConeHalfAngle, DetectionDistance + DetectionSensibility);
+			Registry->QueryInViewCone(Cone, ViewConeCandidateRadius, ViewConeCandidates);
+		}
+		if (ViewConeCandidates.Num() > 1)
+		{
+			auto GetRank = [this](const FHitResult& Hit)
+			{
+				const UFPP_InteractableComponent* Component = HasInteractableComponent(Hit.GetActor());
+				const int32 Rank = Component ? ViewConeCandidates.IndexOfByKey(Component) : INDEX_NONE;
+				return Rank == INDEX_NONE ? MAX_int32 : Rank;
+			};
+			HitResults.StableSort([&GetRank](const FHitResult& A, const FHitResult& B) { return GetRank(A) < GetRank(B); });
+		}
 		UpdateDetectedObject(HitResults);
 	}
 	else
@@ -346,3 +860,64 @@ void UFPP_InteractorComponent::FocusDetection()
 
 
 
+
+
+/**
+ * Measures the publish and read costs of the focus snapshot, with reader threads reading it while it is written.
+ * Usage: FPP.Interaction.FocusSnapshot.Bench [Writes=1000000] [Readers=4]
+ */
+static void FocusSnapshotBench(const TArray<FString>& Args)
+{
+	const int32 NumWrites = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 1000000;
+	const int32 NumReaders = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 0, 16) : 4;
+
+	TSeqLock<FInteractionFocusSnapshot> SeqLock;
+	std::atomic<bool> bStop = false;
+
+	TArray<TFuture<TPair<uint64, double>>> Readers;
+	for (int32 Index = 0; Index < NumReaders; ++Index)
+	{
+		Readers.Add(Async(EAsyncExecution::Thread, [&SeqLock, &bStop]()
+		{
+			uint64 NumReads = 0;
+			float Checksum = 0.0f;
+			const double StartSeconds = FPlatformTime::Seconds();
+			while (!bStop.load(std::memory_order_relaxed))
+			{
+				Checksum += SeqLock.Read().HoldProgress;
+				++NumReads;
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+			return TPair<uint64, double>(NumReads + (Checksum < 0.0f ? 1 : 0), Seconds);
+		}));
+	}
+
+	FInteractionFocusSnapshot Snapshot;
+	Snapshot.bHasFocus = true;
+	const double StartSeconds = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumWrites; ++Index)
+	{
+		Snapshot.HoldProgress = static_cast<float>(Index & 1023) / 1023.0f;
+		Snapshot.ImpactPoint.X = Index;
+		SeqLock.Write(Snapshot);
+	}
+	const double WriteSeconds = FPlatformTime::Seconds() - StartSeconds;
+	bStop = true;
+
+	uint64 TotalReads = 0;
+	double TotalReadSeconds = 0.0;
+	for (TFuture<TPair<uint64, double>>& Reader : Readers)
+	{
+		const TPair<uint64, double> Result = Reader.Get();
+		TotalReads += Result.Key;
+		TotalReadSeconds += Result.Value;
+	}
+
+	UE_LOG(LogFPP_Interaction, Display, TEXT("Focus snapshot: %d writes, %.1f ns per write. %d readers, %llu reads, %.1f ns per read."),
+		NumWrites, WriteSeconds * 1e9 / NumWrites, NumReaders, TotalReads, TotalReads > 0 ? TotalReadSeconds * 1e9 / TotalReads : 0.0);
+}
+
+static FAutoConsoleCommandWithArgs FocusSnapshotBenchCommand(
+	TEXT("FPP.Interaction.FocusSnapshot.Bench"),
+	TEXT("Measures the publish and read costs of the interactor focus snapshot. Usage: FPP.Interaction.FocusSnapshot.Bench [Writes=1000000] [Readers=4]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&FocusSnapshotBench));
@@ -0,0 +1,61 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Subsystems/InteractableCellData.h"
+#include "FPP_Interaction.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "Subsystems/InteractableRegistrySubsystem.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "LinkedCellRegistry.h"
+
+#if WITH_EDITOR
+void UInteractableCellData::BuildForLevel(ULevel* Level)
+{
+	TArray<UFPP_InteractableComponent*> Interactables;
+	TArray<FVector> Locations;
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!Actor || Actor->HasAnyFlags(RF_Transient) || Actor->IsEditorOnly())
+		{
+			continue;
+		}
+
+		TInlineComponentArray<UFPP_InteractableComponent*> ActorInteractables(Actor);
+		for (UFPP_InteractableComponent* Interactable : ActorInteractables)
+		{
+			Interactable->CellEntryIndex = INDEX_NONE;
+			if (Interactable->bUseCellRegistration)
+			{
+				Interactables.Add(Interactable);
+				Locations.Add(Actor->GetActorLocation());
+			}
+		}
+	}
+
+	if (Interactables.IsEmpty())
+	{
+		Level->RemoveUserDataOfClass(UInteractableCellData::StaticClass());
+		return;
+	}
+
+	UInteractableCellData* CellData = Level->GetAssetUserData<UInteractableCellData>();
+	if (!CellData)
+	{
+		CellData = NewObject<UInteractableCellData>(Level);
+		Level->AddAssetUserData(CellData);
+	}
+
+	TArray<int32> Order;
+	CellData->Index.Build(Locations, UInteractableRegistrySubsystem::GetCellSize(), Order);
+	CellData->Components.Reset(Order.Num());
+	CellData->Tags.Reset(Order.Num());
+	for (const int32 SourceIndex : Order)
+	{
+		UFPP_InteractableComponent* Interactable = Interactables[SourceIndex];
+		Interactable->CellEntryIndex = CellData->Components.Add(Interactable);
+		CellData->Tags.Add(Interactable->InteractionConfig ? Interactable->InteractionConfig->InteractionTags : FGameplayTagContainer());
+	}
+}
+
+static FCellDataBuilder GInteractableCellDataBuilder(&UInteractableCellData::BuildForLevel);
+#endif
@@ -0,0 +1,197 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Subsystems/InteractableRegistrySubsystem.h"
+#include "FPP_Interaction.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+#include "FrameArena.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interactable Query"), STAT_InteractableQuery, STATGROUP_FPPInteraction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered Interactables"), STAT_RegisteredInteractables, STATGROUP_FPPInteraction);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Linked Interactable Cells"), STAT_LinkedInteractableCells, STATGROUP_FPPInteraction);
+
+static float GInteractableCellSize = 1000.0f;
+static FAutoConsoleVariableRef CVarInteractableCellSize(
+	TEXT("FPP.Interaction.CellSize"),
+	GInteractableCellSize,
+	TEXT("Size of the cells of the interactables spatial grid, applied when the world is created and when the cell data of a level is built."));
+
+float UInteractableRegistrySubsystem::GetCellSize()
+{
+	return GInteractableCellSize;
+}
+
+void UInteractableRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Interactables.SetCellSize(GInteractableCellSize);
+	LinkedCells.Initialize(GetWorld(), GET_STATFNAME(STAT_LinkedInteractableCells));
+}
+
+void UInteractableRegistrySubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_RegisteredInteractables, Interactables.Num());
+	Interactables.Reset();
+	LinkedCells.Reset();
+
+	Super::Deinitialize();
+}
+
+void UInteractableRegistrySubsystem::RegisterInteractable(UFPP_InteractableComponent* Interactable, const FVector& Location)
+{
+	if (!Interactable)
+	{
+		return;
+	}
+
+	FInteractableEntry Entry;
+	Entry.Component = Interactable;
+	if (Interactable->InteractionConfig)
+	{
+		Entry.Tags = Interactable->InteractionConfig->InteractionTags;
+	}
+
+	Interactables.Add(Entry, Location);
+	INC_DWORD_STAT(STAT_RegisteredInteractables);
+}
+
+void UInteractableRegistrySubsystem::UnregisterInteractable(UFPP_InteractableComponent* Interactable, const FVector& Location)
+{
+	FInteractableEntry Entry;
+	Entry.Component = Interactable;
+	if (Interactables.Remove(Entry, Location))
+	{
+		DEC_DWORD_STAT(STAT_RegisteredInteractables);
+	}
+}
+
+bool UInteractableRegistrySubsystem::LinkCell(ULevel* Level, const UFPP_InteractableComponent* Interactable, int32 CellEntryIndex)
+{
+	// The cell data is built from the locations of the owners
+	return Interactable && LinkedCells.Link(Level, Interactable, CellEntryIndex, Interactable->GetOwner()->GetActorLocation());
+}
+
+void UInteractableRegistrySubsystem::DetachFromCell(const ULevel* Level, int32 CellEntryIndex)
+{
+	LinkedCells.Detach(Level, CellEntryIndex);
+}
+
+void UInteractableRegistrySubsystem::MoveInteractable(UFPP_InteractableComponent* Interactable, const FVector& OldLocation, const FVector& NewLocation)
+{
+	FInteractableEntry Entry;
+	Entry.Component = Interactable;
+	Interactables.Move(Entry, OldLocation, NewLocation);
+}
+
+UFPP_InteractableComponent* UInteractableRegistrySubsystem::FindNearestInteractable(const FVector& Origin, float Radius, const FGameplayTagContainer& RequiredTags, const AActor* IgnoredActor) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractableQuery);
+	GENLIB_PERF_SCOPE("InteractableQuery");
+
+	UFPP_InteractableComponent* Nearest = nullptr;
+	float NearestDistSquared = TNumericLimits<float>::Max();
+	Interactables.ForEachInRadius(Origin, Radius, [&](const FInteractableEntry& Entry, const FVector& Location, float DistSquared)
+	{
+		if (DistSquared >= NearestDistSquared || !Entry.Tags.HasAll(RequiredTags))
+		{
+			return;
+		}
+
+		UFPP_InteractableComponent* Component = Entry.Component.Get();
+		if (Component && Component->GetOwner() != IgnoredActor)
+		{
+			Nearest = Component;
+			NearestDistSquared = DistSquared;
+		}
+	});
+	LinkedCells.ForEachInRadius(Origin, Radius, [&](const UInteractableCellData& CellData, int32 Index, const FVector& Location, float DistSquared)
+	{
+		UFPP_InteractableComponent* Component = CellData.Components[Index];
+		if (DistSquared < NearestDistSquared && Component->GetOwner() != IgnoredActor && CellData.Tags[Index].HasAll(RequiredTags))
+		{
+			Nearest = Component;
+			NearestDistSquared = DistSquared;
+		}
+	});
+	return Nearest;
+}
+
+void UInteractableRegistrySubsystem::QueryInteractables(const FVector& Origin, float Radius, const FGameplayTagContainer& RequiredTags, TArray<UFPP_InteractableComponent*>& OutInteractables) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractableQuery);
+	GENLIB_PERF_SCOPE("InteractableQuery");
+
+	TArray<TPair<float, UFPP_InteractableComponent*>, TInlineAllocator<32, FFrameArenaAllocator>> Found;
+	Interactables.ForEachInRadius(Origin, Radius, [&Found, &RequiredTags](const FInteractableEntry& Entry, const FVector& Location, float DistSquared)
+	{
+		UFPP_InteractableComponent* Component = Entry.Component.Get();
+		if (Component && Entry.Tags.HasAll(RequiredTags))
+		{
+			Found.Emplace(DistSquared, Component);
+		}
+	});
+	LinkedCells.ForEachInRadius(Origin, Radius, [&Found, &RequiredTags](const UInteractableCellData& CellData, int32 Index, const FVector& Location, float DistSquared)
+	{
+		if (CellData.Tags[Index].HasAll(RequiredTags))
+		{
+			Found.Emplace(DistSquared, CellData.Components[Index]);
+		}
+	});
+
+	Found.Sort([](const TPair<float, UFPP_InteractableComponent*>& A, const TPair<float, UFPP_InteractableComponent*>& B) { return A.Key < B.Key; });
+
+	OutInteractables.Reset(Found.Num());
+	for (const TPair<float, UFPP_InteractableComponent*>& Pair : Found)
+	{
+		OutInteractables.Add(Pair.Value);
+	}
+}
+
+void UInteractableRegistrySubsystem::QueryInViewCone(const FViewCone& Cone, float CandidateRadius, TArray<UFPP_InteractableComponent*>& OutInteractables) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractableQuery);
+	GENLIB_PERF_SCOPE("InteractableViewConeQuery");
+
+	ConeCandidates.Reset();
+	ConeComponents.Reset();
+	ConeIndices.Reset();
+	OutInteractables.Reset();
+
+	// The grids only give the interactables around the viewer, the cone is tested on all of them at once
+	const FVector Origin(Cone.Origin);
+	const float Radius = Cone.MaxRange + CandidateRadius;
+	Interactables.ForEachInRadius(Origin, Radius, [this, CandidateRadius](const FInteractableEntry& Entry, const FVector& Location, float DistSquared)
+	{
+		if (UFPP_InteractableComponent* Component = Entry.Component.Get())
+		{
+			ConeComponents.Add(Component);
+			ConeCandidates.Add(Location, CandidateRadius);
+		}
+	});
+	LinkedCells.ForEachInRadius(Origin, Radius, [this, CandidateRadius](const UInteractableCellData& CellData, int32 Index, const FVector& Location, float DistSquared)
+	{
+		ConeComponents.Add(CellData.Components[Index]);
+		ConeCandidates.Add(Location, CandidateRadius);
+	});
+
+	if (FViewConeFilter::Filter(Cone, ConeCandidates, ConeIndices) == 0)
+	{
+		return;
+	}
+
+	TArray<TPair<float, UFPP_InteractableComponent*>, TInlineAllocator<16, FFrameArenaAllocator>> Ranked;
+	for (const int32 Index : ConeIndices)
+	{
+		Ranked.Emplace(FViewConeFilter::GetAlignment(Cone, ConeCandidates.GetLocation(Index)), ConeComponents[Index]);
+	}
+	Ranked.Sort([](const TPair<float, UFPP_InteractableComponent*>& A, const TPair<float, UFPP_InteractableComponent*>& B) { return A.Key > B.Key; });
+
+	OutInteractables.Reserve(Ranked.Num());
+	for (const TPair<float, UFPP_InteractableComponent*>& Pair : Ranked)
+	{
+		OutInteractables.Add(Pair.Value);
+	}
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Subsystems/InteractionEventSubsystem.h"
+#include "FPP_Interaction.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interaction Event Dispatch"), STAT_InteractionEventDispatch, STATGROUP_FPPInteraction);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Interaction Events"), STAT_InteractionEvents, STATGROUP_FPPInteraction);
+
+static bool GInteractionDeferEvents = true;
+static FAutoConsoleVariableRef CVarInteractionDeferEvents(
+	TEXT("FPP.Interaction.DeferEvents"),
+	GInteractionDeferEvents,
+	TEXT("If true, focus and interaction events are delivered in one batch at the end of the frame. If false, they are delivered immediately."));
+
+void FInteractionEventTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target)
+	{
+		Target->DispatchEvents();
+	}
+}
+
+void UInteractionEventSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// After the actors, the physics and the camera updates, so every event of the frame is recorded
+	TickFunction.Target = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bTickEvenWhenPaused = false;
+	TickFunction.TickGroup = TG_PostUpdateWork;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UInteractionEventSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Target = nullptr;
+
+	PendingEvents.Reset();
+	Channels.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UInteractionEventSubsystem::IsDeferring() const
+{
+	return GInteractionDeferEvents && TickFunction.IsTickFunctionRegistered();
+}
+
+void UInteractionEventSubsystem::PostEvent(FInteractionEvent&& Event)
+{
+	PendingEvents.Add(MoveTemp(Event));
+
+	if (!IsDeferring())
+	{
+		DispatchEvents();
+	}
+}
+
+FDelegateHandle UInteractionEventSubsystem::Subscribe(FGameplayTag Channel, FOnInteractionEvent::FDelegate&& Delegate)
+{
+	if (FOnInteractionEvent* Listeners = Channels.Find(Channel))
+	{
+		return Listeners->Add(MoveTemp(Delegate));
+	}
+
+	// Adding a channel while the channels are iterated would invalidate the iteration
+	if (bDispatching)
+	{
+		const FDelegateHandle Handle = Delegate.GetHandle();
+		PendingSubscriptions.Emplace(Channel, MoveTemp(Delegate));
+		return Handle;
+	}
+	return Channels.Add(Channel).Add(MoveTemp(Delegate));
+}
+
+void UInteractionEventSubsystem::Unsubscribe(FGameplayTag Channel, FDelegateHandle Handle)
+{
+	PendingSubscriptions.RemoveAll([Handle](const TPair<FGameplayTag, FOnInteractionEvent::FDelegate>& Subscription)
+	{
+		return Subscription.Value.GetHandle() == Handle;
+	});
+
+	if (FOnInteractionEvent* Listeners = Channels.Find(Channel))
+	{
+		Listeners->Remove(Handle);
+		if (!Listeners->IsBound() && !bDispatching)
+		{
+			Channels.Remove(Channel);
+		}
+	}
+}
+
+/**
+ * Delivers the events recorded since the last dispatch, in the order they were recorded.
+ * The buffers are swapped first, so the events posted by the listeners are delivered in the next dispatch.
+ */
+void UInteractionEventSubsystem::DispatchEvents()
+{
+	if (bDispatching || PendingEvents.IsEmpty())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_InteractionEventDispatch);
+	GENLIB_PERF_SCOPE("InteractionEventDispatch");
+
+	{
+		TGuardValue<bool> DispatchingGuard(bDispatching, true);
+		do
+		{
+			DeliverPendingEvents();
+		}
+		// Without deferring, the events posted by the listeners are delivered right away too
+		while (!IsDeferring() && !PendingEvents.IsEmpty());
+	}
+
+	for (TPair<FGameplayTag, FOnInteractionEvent::FDelegate>& Subscription : PendingSubscriptions)
+	{
+		Channels.FindOrAdd(Subscription.Key).Add(MoveTemp(Subscription.Value));
+	}
+	PendingSubscriptions.Reset();
+}
+
+void UInteractionEventSubsystem::DeliverPendingEvents()
+{
+	INC_DWORD_STAT_BY(STAT_InteractionEvents, PendingEvents.Num());
+
+	Swap(PendingEvents, DispatchingEvents);
+	for (const FInteractionEvent& Event : DispatchingEvents)
+	{
+		for (const TPair<FGameplayTag, FOnInteractionEvent>& Channel : Channels)
+		{
+			if (!Channel.Key.IsValid() || Event.Tags.HasTag(Channel.Key))
+			{
+				Channel.Value.Broadcast(Event);
+			}
+		}
+
+		// The Blueprint delegates of the interactable last, after the native systems reacted
+		if (UFPP_InteractableComponent* Interactable = Event.Interactable.Get())
+		{
+			Interactable->DeliverEvent(Event);
+		}
+	}
+
+	// Reset keeps the memory, so the buffers don't allocate once they reached the usual size
+	DispatchingEvents.Reset();
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Subsystems/InteractionLatencySubsystem.h"
+#include "FPP_Interaction.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static bool GInteractionLatencyEnabled = true;
+static FAutoConsoleVariableRef CVarInteractionLatency(
+	TEXT("FPP.Interaction.Latency"),
+	GInteractionLatencyEnabled,
+	TEXT("If true, the latencies from the interaction inputs to their effect are recorded."));
+
+namespace InteractionLatency
+{
+	static const TCHAR* GetName(EInteractionLatency Latency)
+	{
+		switch (Latency)
+		{
+		case EInteractionLatency::FocusAge: return TEXT("FocusAge");
+		case EInteractionLatency::InputToFocus: return TEXT("InputToFocus");
+		case EInteractionLatency::InputToEffect: return TEXT("InputToEffect");
+		default: return TEXT("Unknown");
+		}
+	}
+}
+
+bool UInteractionLatencySubsystem::IsEnabled()
+{
+	return GInteractionLatencyEnabled;
+}
+
+void UInteractionLatencySubsystem::Record(EInteractionLatency Latency, const UClass* InteractableClass, double Seconds)
+{
+	if (!GInteractionLatencyEnabled || !InteractableClass)
+	{
+		return;
+	}
+
+	Latencies.FindOrAdd(InteractableClass->GetFName())[static_cast<int32>(Latency)].Add(Seconds * 1000.0);
+}
+
+void UInteractionLatencySubsystem::DumpToLog() const
+{
+	UE_LOG(LogFPP_Interaction, Display, TEXT("Interaction latencies (ms) of %s:"), *GetNameSafe(GetWorld()));
+	for (const TPair<FName, FLatencyHistograms>& Class : Latencies)
+	{
+		for (int32 Index = 0; Index < Class.Value.Num(); ++Index)
+		{
+			const FLatencyHistogram& Histogram = Class.Value[Index];
+			if (Histogram.Num() > 0)
+			{
+				UE_LOG(LogFPP_Interaction, Display, TEXT("  %s %s: %llu samples, avg %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f"),
+					*Class.Key.ToString(), InteractionLatency::GetName(static_cast<EInteractionLatency>(Index)), Histogram.Num(),
+					Histogram.GetAverage(), Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9), Histogram.GetPercentile(0.99), Histogram.GetMax());
+			}
+		}
+	}
+}
+
+bool UInteractionLatencySubsystem::WriteCsv(const FString& Path) const
+{
+	FString Csv = TEXT("Class,Latency,Samples,AvgMs,P50Ms,P90Ms,P95Ms,P99Ms,MaxMs\n");
+	for (const TPair<FName, FLatencyHistograms>& Class : Latencies)
+	{
+		for (int32 Index = 0; Index < Class.Value.Num(); ++Index)
+		{
+			const FLatencyHistogram& Histogram = Class.Value[Index];
+			if (Histogram.Num() > 0)
+			{
+				Csv += FString::Printf(TEXT("%s,%s,%llu,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f\n"),
+					*Class.Key.ToString(), InteractionLatency::GetName(static_cast<EInteractionLatency>(Index)), Histogram.Num(), Histogram.GetAverage(),
+					Histogram.GetPercentile(0.5), Histogram.GetPercentile(0.9), Histogram.GetPercentile(0.95), Histogram.GetPercentile(0.99), Histogram.GetMax());
+			}
+		}
+	}
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+void UInteractionLatencySubsystem::Reset()
+{
+	Latencies.Reset();
+}
+
+static FAutoConsoleCommandWithWorldAndArgs InteractionLatencyDumpCommand(
+	TEXT("FPP.Interaction.Latency.Dump"),
+	TEXT("Logs the percentiles of the interaction latencies per interactable class."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (const UInteractionLatencySubsystem* Latency = World ? World->GetSubsystem<UInteractionLatencySubsystem>() : nullptr)
+		{
+			Latency->DumpToLog();
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs InteractionLatencyCsvCommand(
+	TEXT("FPP.Interaction.Latency.Csv"),
+	TEXT("Writes the percentiles of the interaction latencies to a CSV file. Usage: FPP.Interaction.Latency.Csv [Path]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		const UInteractionLatencySubsystem* Latency = World ? World->GetSubsystem<UInteractionLatencySubsystem>() : nullptr;
+		if (!Latency)
+		{
+			return;
+		}
+
+		const FString Path = Args.Num() > 0 ? Args[0]
+			: FPaths::ProfilingDir() / TEXT("InteractionLatency") / FString::Printf(TEXT("%s_%s.csv"), *World->GetMapName(), *FDateTime::Now().ToString());
+		if (Latency->WriteCsv(Path))
+		{
+			UE_LOG(LogFPP_Interaction, Display, TEXT("Interaction latencies written to %s"), *Path);
+		}
+		else
+		{
+			UE_LOG(LogFPP_Interaction, Error, TEXT("Failed to write the interaction latencies to %s"), *Path);
+		}
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs InteractionLatencyResetCommand(
+	TEXT("FPP.Interaction.Latency.Reset"),
+	TEXT("Clears the recorded interaction latencies."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UInteractionLatencySubsystem* Latency = World ? World->GetSubsystem<UInteractionLatencySubsystem>() : nullptr)
+		{
+			Latency->Reset();
+		}
+	}));
@@ -0,0 +1,148 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Subsystems/InteractionPresentationSubsystem.h"
+#include "FPP_Interaction.h"
+#include "UI/InteractionPromptWidget.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("Interaction Prompt Update"), STAT_InteractionPromptUpdate, STATGROUP_FPPInteraction);
+
+void UInteractionPresentationSubsystem::Deinitialize()
+{
+	ClearFocus();
+
+	if (Prompt)
+	{
+		Prompt->RemoveFromParent();
+		Prompt = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+bool UInteractionPresentationSubsystem::IsTickable() const
+{
+	// Nothing to move while nothing is focused
+	return Prompt && FocusedPrimitive.IsValid();
+}
+
+TStatId UInteractionPresentationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInteractionPresentationSubsystem, STATGROUP_Tickables);
+}
+
+void UInteractionPresentationSubsystem::Tick(float DeltaTime)
+{
+	UpdatePromptPosition();
+}
+
+void UInteractionPresentationSubsystem::SetFocus(UFPP_InteractableComponent* Interactable, UPrimitiveComponent* Primitive)
+{
+	if (Interactable == FocusedInteractable.Get() && Primitive == FocusedPrimitive.Get())
+	{
+		return;
+	}
+
+	ClearFocus();
+	FocusedInteractable = Interactable;
+	FocusedPrimitive = Primitive;
+
+	if (Primitive)
+	{
+		bPreviousRenderCustomDepth = Primitive->bRenderCustomDepth;
+		PreviousStencilValue = Primitive->CustomDepthStencilValue;
+		Primitive->SetRenderCustomDepth(true);
+		Primitive->SetCustomDepthStencilValue(FocusStencilValue);
+	}
+
+	if (UInteractionPromptWidget* PromptWidget = GetOrCreatePrompt())
+	{
+		PromptWidget->OnPromptTargetChanged(Interactable);
+		UpdatePromptPosition();
+	}
+}
+
+void UInteractionPresentationSubsystem::ClearFocus()
+{
+	if (UPrimitiveComponent* Primitive = FocusedPrimitive.Get())
+	{
+		Primitive->SetRenderCustomDepth(bPreviousRenderCustomDepth);
+		Primitive->SetCustomDepthStencilValue(PreviousStencilValue);
+	}
+	FocusedInteractable.Reset();
+	FocusedPrimitive.Reset();
+
+	if (Prompt)
+	{
+		Prompt->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+void UInteractionPresentationSubsystem::UpdatePromptPosition()
+{
+	SCOPE_CYCLE_COUNTER(STAT_InteractionPromptUpdate);
+
+	const UPrimitiveComponent* Primitive = FocusedPrimitive.Get();
+	const APlayerController* PlayerController = GetLocalPlayer()->GetPlayerController(GetLocalPlayer()->GetWorld());
+	if (!Prompt || !Primitive || !PlayerController)
+	{
+		return;
+	}
+
+	const FBoxSphereBounds& Bounds = Primitive->Bounds;
+	const FVector PromptLocation = Bounds.Origin + FVector(0.0f, 0.0f, Bounds.BoxExtent.Z + PromptHeightOffset);
+
+	FVector2D ScreenLocation;
+	if (PlayerController->ProjectWorldLocationToScreen(PromptLocation, ScreenLocation, true))
+	{
+		Prompt->SetPositionInViewport(ScreenLocation);
+		Prompt->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+	else
+	{
+		Prompt->SetVisibility(ESlateVisibility::Collapsed);
+	}
+}
+
+/**
+ * Creates the prompt the first time something is focused, and keeps it while its player controller lives.
+ * A map travel replaces the player controller and removes the widgets from the viewport, the prompt is then created again.
+ */
+UInteractionPromptWidget* UInteractionPresentationSubsystem::GetOrCreatePrompt()
+{
+	if (PromptWidgetClass.IsNull())
+	{
+		return nullptr;
+	}
+
+	APlayerController* PlayerController = GetLocalPlayer()->GetPlayerController(GetLocalPlayer()->GetWorld());
+	if (Prompt)
+	{
+		if (Prompt->GetOwningPlayer() == PlayerController && Prompt->IsInViewport())
+		{
+			return Prompt;
+		}
+
+		Prompt->RemoveFromParent();
+		Prompt = nullptr;
+	}
+
+	UClass* WidgetClass = PromptWidgetClass.LoadSynchronous();
+	if (!PlayerController || !WidgetClass)
+	{
+		UE_LOG(LogFPP_Interaction, Warning, TEXT("The interaction prompt can't be created. %s"), *FPPINTERACTION_LOGS_LINE);
+		return nullptr;
+	}
+
+	Prompt = CreateWidget<UInteractionPromptWidget>(PlayerController, WidgetClass);
+	if (Prompt)
+	{
+		Prompt->SetAlignmentInViewport(FVector2D(0.5f, 1.0f));
+		Prompt->SetVisibility(ESlateVisibility::Collapsed);
+		Prompt->AddToPlayerScreen();
+	}
+	return Prompt;
+}
@@ -0,0 +1,37 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/BTTaskNode.h"
+#include "GameplayTagContainer.h"
+#include "BTTask_InteractWithNearest.generated.h"
+
+/**
+ * Behaviour tree task making the pawn interact with the closest visible interactable having the required tags.
+ * The pawn needs a UFPP_InteractorComponent, the interactables are found through the registry of the world.
+ */
+UCLASS()
+class FPP_INTERACTION_API UBTTask_InteractWithNearest : public UBTTaskNode
+{
+	GENERATED_BODY()
+
+public:
+	UBTTask_InteractWithNearest();
+
+	virtual void InitializeFromAsset(UBehaviorTree& Asset) override;
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual FString GetStaticDescription() const override;
+
+	// Maximum distance of the interactable from the pawn
+	UPROPERTY(EditAnywhere, Category = "Interaction", meta = (ClampMin = "0.0", UIMin = "0.0"))
+	float SearchRadius = 300.0f;
+
+	// Tags the interaction config of the interactable must have. Empty accepts any interactable
+	UPROPERTY(EditAnywhere, Category = "Interaction")
+	FGameplayTagContainer RequiredTags;
+
+	// Optional key receiving the actor interacted with
+	UPROPERTY(EditAnywhere, Category = "Blackboard")
+	FBlackboardKeySelector TargetActorKey;
+};
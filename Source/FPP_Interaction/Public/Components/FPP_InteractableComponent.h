@@ -6,6 +6,8 @@
 #include "Components/ActorComponent.h"
 #include "FPP_InteractorComponent.h"
 #include "Config/InteractionConfig.h"
+#include "Core/InteractionTypes.h"
+#include "Subsystems/InteractionEventSubsystem.h"
 #include "FPP_InteractableComponent.generated.h"
 
 /**
@@ -14,6 +16,8 @@
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnFocusChanged, bool, bIsFocused);
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnInteractableStateChanged, EInteractableState, NewState);
+
 /**
  * Represents an interactable component that can be used to define interaction behavior for actors in a game.
  * This component includes configurable interaction data and provides mechanisms for managing interaction focus states.
@@ -35,6 +39,11 @@ protected:
 	 */
 	virtual void BeginPlay() override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Removes the interactable from the registry of the world
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	UPROPERTY(blueprintReadWrite, EditAnywhere, Category = "Debug")
 	bool bActivateDebugLogs = false;
 
@@ -56,8 +65,39 @@ public:
 	 * @param HitResult The hit result containing information about the interaction, including location and hit object.
 	 * @param InteractorComponent A pointer to the interactor component initiating the interaction.
 	 * @param InputAction A pointer to the input action associated with the interaction trigger.
+	 * @return False if the interactable is disabled or in cooldown.
+	 */
+	bool Interact(FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent, const UInputAction* InputAction);
+
+	// Returns the current state and cooldown
+	FInteractableStateSnapshot GetSnapshot() const;
+
+	/**
+	 * Records the state before a predicted interaction of the local client.
+	 *
+	 * @param PredictionKey Key of the prediction, sent to the server with the interaction.
 	 */
-	void Interact(FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent, const UInputAction* InputAction);
+	void BeginPrediction(uint16 PredictionKey);
+
+	/**
+	 * Resolves a predicted interaction with the answer of the server.
+	 * A rejected prediction rolls the interactable back to the state recorded before it, and drops the later ones.
+	 *
+	 * @param PredictionKey Key of the prediction.
+	 * @param bAccepted True if the server accepted the interaction.
+	 * @param AuthoritativeState State of the interactable on the server after the interaction.
+	 */
+	void ResolvePrediction(uint16 PredictionKey, bool bAccepted, const FInteractableStateSnapshot& AuthoritativeState);
+
+	// Checks if interactions predicted by the local client are waiting for the server
+	FORCEINLINE bool HasPendingPredictions() const { return !PendingPredictions.IsEmpty(); }
+
+	/**
+	 * Broadcasts an event delivered by the UInteractionEventSubsystem to the Blueprint delegates of the interactable.
+	 *
+	 * @param Event The focus or interaction event.
+	 */
+	void DeliverEvent(const FInteractionEvent& Event);
 
 	/**
 	 * Gets the current focus state of the interactable component.
@@ -67,17 +107,140 @@ public:
 	//UFUNCTION(BlueprintPure)
 	//bool IsInFocus() const;
 	
-	/** Delegate to broadcast when the focus state changes */
+	/** Delegate to broadcast when the focus state changes, delivered at the end of the frame with the other interaction events */
 	UPROPERTY(BlueprintAssignable, Category = "Components|Interaction")
 	FOnFocusChanged OnFocus;
 
+	/** If true and the owner is placed in a level, the interactable is registered with the cell data of its level */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup")
+	bool bUseCellRegistration = true;
+
+	/** Tag of the primitive highlighted when the interactable is focused. If None, the primitive hit by the detection is highlighted */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup")
+	FName HighlightComponentTag;
+
+	/**
+	 * Returns the primitive to highlight when the interactable is focused.
+	 *
+	 * @param FocusHit The hit of the detection that focused the interactable.
+	 * @return The primitive with HighlightComponentTag, or the primitive hit.
+	 */
+	UPrimitiveComponent* GetHighlightPrimitive(const FHitResult& FocusHit) const;
+
 	/** Configuration data defining interaction behavior for this component */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup")
 	UInteractionConfig* InteractionConfig;
 
+	/**
+	 * Changes the persistent state of the interactable and broadcasts OnStateChanged if it is different.
+	 *
+	 * @param NewState The new state.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|Interaction")
+	void SetInteractableState(EInteractableState NewState);
+
+	UFUNCTION(BlueprintPure, Category = "Components|Interaction")
+	FORCEINLINE EInteractableState GetInteractableState() const { return InteractableState; }
+
+	// Returns the seconds left before the interactable can be used again
+	UFUNCTION(BlueprintPure, Category = "Components|Interaction")
+	float GetCooldownRemaining() const;
+
+	/**
+	 * Restores a saved state and cooldown, without broadcasting OnStateChanged.
+	 * Intended to be called by the persistence before the interactable begins play.
+	 *
+	 * @param SavedState The saved state.
+	 * @param CooldownRemaining Seconds of cooldown left when the state was saved.
+	 */
+	void RestoreState(EInteractableState SavedState, float CooldownRemaining);
+
+	/** Delegate to broadcast when the persistent state changes, predicted, replicated or rolled back included */
+	UPROPERTY(BlueprintAssignable, Category = "Components|Interaction")
+	FOnInteractableStateChanged OnStateChanged;
+
+	/** If true, the interactions of clients are applied locally right away and confirmed by the server */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup")
+	bool bPredictInteractions = true;
+
+	/**
+	 * If true, the server puts an awake owner to sleep when it begins play, so it isn't considered
+	 * for replication until its state changes. The state changes flush the dormancy of the owner.
+	 * Pawns and owners replicating their movement are never put to sleep, see CanOwnerBeDormant.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup")
+	bool bDormantByDefault = true;
+
+	/**
+	 * Checks if an actor only replicates when its state changes, so it can sleep until then.
+	 * Pawns and actors replicating their movement keep replicating on their own.
+	 *
+	 * @param Actor The replicated actor.
+	 */
+	static bool CanOwnerBeDormant(const AActor* Actor);
+
+	// Checks if the owner is put to sleep when it begins play
+	bool IsOwnerDormantByDefault() const;
+
+	/**
+	 * Moves the interactable to the current location of its owner in the registry of the world.
+	 * Call it after moving an interactable actor, so the AI interactors find it where it is.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Components|Interaction")
+	void UpdateRegisteredLocation();
+
 	//Temporary for prototyping in blueprints
 	UFUNCTION(BlueprintNativeEvent, Category = "Components|Interaction")
 	void BpInteracted (FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent, const UInputAction* InputAction);
 
 	virtual void BpInteracted_Implementation(FHitResult HitResult, UFPP_InteractorComponent* InteractorComponent, const UInputAction* InputAction) { }
+
+private:
+	// Fills the common fields of an event and posts it to the event bus of the world
+	void PostEvent(FInteractionEvent&& Event);
+
+	// Location used to register the interactable, needed to find it in the spatial index
+	FVector RegisteredLocation = FVector::ZeroVector;
+
+	bool bRegistered = false;
+
+	// Index in the cell data of the level, set when the level is saved or cooked
+	UPROPERTY()
+	int32 CellEntryIndex = INDEX_NONE;
+
+	// True if the interactable is found through the linked cell data of its level
+	bool bLinkedToCell = false;
+
+	UPROPERTY(VisibleInstanceOnly, ReplicatedUsing = OnRep_InteractableState, Category = "Components|Interaction")
+	EInteractableState InteractableState = EInteractableState::Idle;
+
+	UFUNCTION()
+	void OnRep_InteractableState(EInteractableState PreviousState);
+
+	// Answers a delivered predicted interaction on the server, records its predicted state on the client
+	void RecordPredictionEffect(const FInteractionEvent& Event);
+
+	// Applies a snapshot, broadcasting OnStateChanged if the state changes
+	void ApplySnapshot(const FInteractableStateSnapshot& Snapshot);
+
+	// Marks the replicated state dirty and sends it once to the clients while the owner stays dormant
+	void MarkStateDirty();
+
+	struct FPendingPrediction
+	{
+		uint16 Key = 0;
+		FInteractableStateSnapshot PreviousState;
+
+		// State after the predicted event was delivered, re-applied over the replicated state
+		FInteractableStateSnapshot PredictedState;
+		bool bHasPredictedState = false;
+	};
+
+	// Interactions predicted by the local client, oldest first
+	TArray<FPendingPrediction, TInlineAllocator<2>> PendingPredictions;
+
+	// World time when the cooldown of the config ends
+	float CooldownEndTime = 0.0f;
+
+	friend class UInteractableCellData;
 };
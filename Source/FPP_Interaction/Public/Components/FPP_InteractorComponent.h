@@ -5,7 +5,8 @@
 /**
  * This component is intended to be added to a Pawn that requires detection of interactable objects,
  * If the owner is player, through player inputs to interact with objects in the game.
- * TODO: If owner is AIControlled
+ * If the owner is AI controlled, there is no periodic detection: the AI queries the interactables registry
+ * on demand (behaviour tree tasks or EQS) and validates the line of sight of the chosen target only.
  * The interactable objects must implement the UFPPInteractableComponent to be compatible
  * with this interaction system.
  */
@@ -15,12 +16,33 @@
 #include "Components/ActorComponent.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "InputAction.h"
+#include "GameplayTagContainer.h"
+#include "Core/InteractionTypes.h"
+#include "Subsystems/InteractionLatencySubsystem.h"
+#include "SeqLock.h"
 #include "FPP_InteractorComponent.generated.h"
 
 
 
 class UFPP_InteractableComponent;
 class UCameraComponent;
+class AController;
+class UInteractionPresentationSubsystem;
+class UInputMappingContext;
+class UEnhancedInputLocalPlayerSubsystem;
+class UEnhancedInputComponent;
+
+// How the interactor finds the interactables
+UENUM(BlueprintType)
+enum class EInteractorMode : uint8
+{
+	// Player if the pawn is player controlled, AI otherwise
+	Auto UMETA(DisplayName = "Auto"),
+	// Periodic traces from the camera, interactions from the inputs
+	Player UMETA(DisplayName = "Player"),
+	// Queries on demand to the interactables registry, no periodic traces
+	AI UMETA(DisplayName = "AI")
+};
 
 UCLASS( ClassGroup=(Interaction), Blueprintable, meta=(BlueprintSpawnableComponent) )
 class FPP_INTERACTION_API UFPP_InteractorComponent : public UActorComponent
@@ -34,12 +56,17 @@ public:
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:	
 	/*
 	 * Variables
 	 */
 
+	// How the interactables are found. Auto resolves it from the controller of the pawn
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection")
+	EInteractorMode InteractorMode = EInteractorMode::Auto;
+
 	// Frequency (in seconds) to perform object detection. Default set to 0.1f (100ms)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection", meta=(ClampMin = "0.01", UIMin = "0.01"))
 	float DetectionFrequency = 0.1f;
@@ -59,6 +86,22 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection",meta=(ClampMin = "1.0", UIMin = "1.0"))
 	float DetectionSensibility = 20.0f;
 	
+	/**
+	 * If true, the hits of the detection trace are ranked by how centered their interactable is in a view cone
+	 * from the camera, using the registered locations. It only ranks: the registry doesn't follow moving
+	 * interactables, so the trace always runs and the hits outside of the cone keep their order after the others.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection")
+	bool bPrefilterWithViewCone = true;
+
+	// Half angle in degrees of the view cone of the prefilter
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection", meta=(EditCondition = "bPrefilterWithViewCone", ClampMin = "1.0", ClampMax = "90.0"))
+	float ViewConeHalfAngle = 45.0f;
+
+	// Radius around the location of the interactables accepted by the view cone, for the parts of the actors far from their root
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection", meta=(EditCondition = "bPrefilterWithViewCone", ClampMin = "0.0"))
+	float ViewConeCandidateRadius = 100.0f;
+
 	// Start offset of the trace from the camara
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Detection")
 	FVector StartOffset = FVector(0.0f, 0.0f, 0.0f);
@@ -72,6 +115,20 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Setup|Inputs")
 	TSet<TObjectPtr<class UInputAction>> InteractionActions;
+
+	/**
+	 * Mapping context with the keys of the interaction actions. It is added to the local player only while an
+	 * interactable is focused, with the mappings of the input action required by its config.
+	 * If not set, the interaction actions must be mapped by a context of the game.
+	 * Nothing is mapped while nothing is focused, so the InputToFocus latency is only measured without it,
+	 * or when a context of the game maps the interaction actions too.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup|Inputs")
+	TObjectPtr<UInputMappingContext> InteractionMappingContext;
+
+	// Priority of the interaction mapping context in the local player
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Setup|Inputs")
+	int32 InteractionMappingPriority = 1;
 	
 	// Stores the result from a detection trace
 	FHitResult FocusedHit;
@@ -83,6 +140,26 @@ private:
 	//Reference of the camera
 	UCameraComponent* PlayerCamera;
 
+	// Mode resolved from InteractorMode and the controller of the pawn, never Auto
+	EInteractorMode ResolvedMode = EInteractorMode::Player;
+
+	// Subsystem showing the current focus to the local player
+	TWeakObjectPtr<UInteractionPresentationSubsystem> FocusPresentation;
+
+	// Input subsystem of the local player where ActiveMappingContext is added
+	TWeakObjectPtr<UEnhancedInputLocalPlayerSubsystem> MappedInputSubsystem;
+
+	// Input component of the owner the interaction actions are bound to, recreated when a player possesses it again
+	TWeakObjectPtr<UEnhancedInputComponent> BoundInputComponent;
+
+	// Filtered mapping context added for the focused interactable
+	UPROPERTY(Transient)
+	TObjectPtr<UInputMappingContext> ActiveMappingContext;
+
+	// Mapping contexts with only the mappings of one input action, built once per action
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<const UInputAction>, TObjectPtr<UInputMappingContext>> FilteredMappingContexts;
+
 	
 	/*
 	 * Functions
@@ -104,12 +181,68 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Interaction")
 	FORCEINLINE bool IsFocusing() const { return FocusedHit.bBlockingHit; }
 
+	/**
+	 * Returns the last published focus of the interactor. Safe to call from any thread,
+	 * e.g. the thread safe update of an Animation Blueprint or async UI code.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Interaction", meta = (BlueprintThreadSafe))
+	FInteractionFocusSnapshot GetFocusSnapshot() const { return FocusSnapshot.Read(); }
+
+	// Returns the platform time of the input being handled, 0 outside of the interaction input handling
+	FORCEINLINE double GetInteractionInputSeconds() const { return InteractionInputSeconds; }
+
+	// Returns the key of the predicted interaction being handled, 0 outside of it or if it isn't predicted
+	FORCEINLINE uint16 GetInteractionPredictionKey() const { return InteractionPredictionKey; }
+
+	/**
+	 * Answers a predicted interaction of the owning client, once its event is delivered on the server.
+	 *
+	 * @param Interactable The interactable of the interaction.
+	 * @param PredictionKey Key of the prediction.
+	 */
+	void SendInteractResult(UFPP_InteractableComponent* Interactable, uint16 PredictionKey);
+
+	// Returns the resolved mode of the interactor, Player or AI
+	UFUNCTION(BlueprintPure, Category = "Interaction")
+	FORCEINLINE EInteractorMode GetResolvedMode() const { return ResolvedMode; }
+
+	/**
+	 * Finds the closest interactable in the registry of the world and focuses it if it is in line of sight.
+	 * Intended for the AI mode, only one line trace is done for the chosen interactable.
+	 *
+	 * @param Radius Maximum distance of the interactable from the owner.
+	 * @param RequiredTags Tags the interaction config of the interactable must have. Empty accepts any interactable.
+	 * @return The interactable focused, or nullptr if none is found or visible.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	UFPP_InteractableComponent* FindInteractable(float Radius, FGameplayTagContainer RequiredTags);
+
+	/**
+	 * Interacts with an interactable without going through the inputs, with its required input action.
+	 *
+	 * @param Interactable The interactable, usually the one returned by FindInteractable.
+	 * @return True if the interaction happened.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	bool InteractWith(UFPP_InteractableComponent* Interactable);
+
 	// helper function to find an interactable component on an actor
 	UFPP_InteractableComponent* HasInteractableComponent(const AActor* Actor);	
 
 	void BindInputActions();
 
 	void HandleTriggerInputAction(const FInputActionInstance& instance);
+
+	/**
+	 * Interacts with an interactable with the authority of the server.
+	 * On a client, the interaction is predicted locally and sent to the server, which confirms or rejects it.
+	 *
+	 * @param Interactable The interactable.
+	 * @param HitResult The hit that focused the interactable.
+	 * @param InputAction The input action of the interaction.
+	 * @return True if the interaction happened, or was predicted.
+	 */
+	bool RequestInteract(UFPP_InteractableComponent* Interactable, const FHitResult& HitResult, const UInputAction* InputAction);
 	void HandleStopInputAction(const FInputActionInstance& instance);
 	void HandleOnGoingInputAction(const FInputActionInstance& instance);
 
@@ -124,14 +257,81 @@ private:
 	// Initializes the component (e.g., sets up initial data or state)
 	void Initialize();
 
+	// Resolves the mode of the interactor from InteractorMode and the controller of the pawn
+	EInteractorMode ResolveMode() const;
+
+	// Validates and applies an interaction predicted by the owning client
+	UFUNCTION(Server, Reliable)
+	void ServerInteract(UFPP_InteractableComponent* Interactable, const UInputAction* InputAction, uint16 PredictionKey);
+
+	// Answer of the server to an interaction of the owning client, predicted or not
+	UFUNCTION(Client, Reliable)
+	void ClientInteractResult(UFPP_InteractableComponent* Interactable, uint16 PredictionKey, bool bAccepted, FInteractableStateSnapshot AuthoritativeState);
+
+	// Key of the last interaction sent to the server, 0 is never used
+	uint16 LastPredictionKey = 0;
+
+	// Keys and input platform times of the interactions without prediction waiting for the server
+	TArray<TPair<uint16, double>, TInlineAllocator<4>> AwaitedInputs;
+	static constexpr int32 MaxAwaitedInputs = 4;
+
+	// Key of the predicted interaction being handled, passed to its event
+	uint16 InteractionPredictionKey = 0;
+
+	// Platform times of the input being handled, of the last detection confirming the focus,
+	// and of the last input pressed with nothing to interact with
+	double InteractionInputSeconds = 0.0;
+	double FocusConfirmedSeconds = 0.0;
+	double UnfocusedInputSeconds = 0.0;
+
+	// Progress of the hold interaction in progress, from 0 to 1
+	float HoldProgress = 0.0f;
+
+	// Focus published for the other threads, written only by the game thread when it changes
+	TSeqLock<FInteractionFocusSnapshot> FocusSnapshot;
+
+	// Publishes the current focus and hold progress to FocusSnapshot
+	void PublishFocusSnapshot();
+
+	// Records a latency of the interactable in the latency subsystem of the world
+	void RecordLatency(EInteractionLatency Latency, const AActor* Interactable, double Seconds) const;
+
+	// Resolves the mode again when the pawn is possessed by another controller
+	UFUNCTION()
+	void HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
 	// Handles the detection logic for interactable objects
 	void FocusDetection();
 	
 	// This function updates the currently detected object(s) based on the provided hit results from a detection trace
-	void UpdateDetectedObject(TArray<FHitResult> HitResults);
+	void UpdateDetectedObject(const TArray<FHitResult>& HitResults);
+
+	// Hits of the last detection trace, kept so the trace does not allocate every tick
+	TArray<FHitResult> DetectionHits;
+
+	// Interactables in the view cone of the last detection with several hits, the most centered first
+	TArray<UFPP_InteractableComponent*> ViewConeCandidates;
 	
-	// Clears the currently focused object and resets related states
-	void ClearFocusedObject();
+	/**
+	 * Clears the currently focused object and resets related states.
+	 *
+	 * @param bRemoveInputMapping False when another interactable is focused right after, its mapping replaces the current one.
+	 */
+	void ClearFocusedObject(bool bRemoveInputMapping = true);
+
+	// Returns the subsystem showing the focus to the local player, nullptr if the owner is not a local player
+	UInteractionPresentationSubsystem* GetPresentationSubsystem() const;
+
+	/**
+	 * Adds the mapping context of the input action required by the focused interactable to the local player,
+	 * replacing the previous one, or removes it when nothing is focused.
+	 *
+	 * @param Focused The focused interactable, nullptr when the focus is cleared.
+	 */
+	void UpdateInputMapping(const UFPP_InteractableComponent* Focused);
+
+	// Returns the mapping context with only the mappings of an input action, the whole context if it is nullptr
+	UInputMappingContext* GetFilteredMappingContext(const UInputAction* InputAction);
 };
 
 
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "InputAction.h"
 #include "Engine/DataAsset.h"
+#include "GameplayTagContainer.h"
 #include "InteractionConfig.generated.h"
 
 UENUM(BlueprintType)
@@ -32,6 +33,10 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
 	EInputType InputType = EInputType::Press;
+
+	// Seconds the input is held to interact, used for the hold progress. It should match the trigger of the input action
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (EditCondition = "InputType == EInputType::Hold", ClampMin = "0.0"))
+	float HoldDuration = 1.0f;
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
 	float CooldownTime;
@@ -41,4 +46,8 @@ public:
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction", meta = (EditCondition = "bChangeDetectionDistance"))
 	float DetectionDistance = 10.0f;
+
+	// Tags describing the interactable (e.g. Interaction.Door), used by the AI to find the interactables they need
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Interaction")
+	FGameplayTagContainer InteractionTags;
 };
@@ -0,0 +1,59 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "InteractionTypes.generated.h"
+
+// Persistent state of an interactable, e.g. a container that has been opened
+UENUM(BlueprintType)
+enum class EInteractableState : uint8
+{
+	Idle UMETA(DisplayName = "Idle"),
+	Opened UMETA(DisplayName = "Opened"),
+	Disabled UMETA(DisplayName = "Disabled")
+};
+
+/**
+ * State of an interactable at a point in time, used to roll back the interactions predicted by a client.
+ */
+USTRUCT()
+struct FPP_INTERACTION_API FInteractableStateSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EInteractableState State = EInteractableState::Idle;
+
+	// Cooldown left, relative so it is valid on the server and the clients
+	UPROPERTY()
+	float CooldownRemaining = 0.0f;
+};
+
+/**
+ * Compact copy of the focus of an interactor, published for the animation and UI code running on worker threads.
+ * It is trivially copyable so it can be read without locks. The actor may only be resolved on the game thread.
+ */
+USTRUCT(BlueprintType)
+struct FPP_INTERACTION_API FInteractionFocusSnapshot
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	TWeakObjectPtr<AActor> FocusedActor;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	// First tag of the interaction config of the focused interactable
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	FGameplayTag InteractionType;
+
+	// Progress of the hold interaction, from 0 to 1
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	float HoldProgress = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Interaction")
+	bool bHasFocus = false;
+};
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Stats/Stats.h"
 
 // Macros for cleaner logging
 #define FPPINTERACTION_PRINT_FILE (FString(FPaths::GetCleanFilename(TEXT(__FILE__))))
@@ -11,6 +12,8 @@
 
 DECLARE_LOG_CATEGORY_EXTERN(LogFPP_Interaction, Log, All);
 
+DECLARE_STATS_GROUP(TEXT("FPP Interaction"), STATGROUP_FPPInteraction, STATCAT_Advanced);
+
 class FFPP_InteractionModule : public IModuleInterface
 {
 public:
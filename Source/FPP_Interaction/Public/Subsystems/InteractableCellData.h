@@ -0,0 +1,45 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "GameplayTagContainer.h"
+#include "SpatialCellIndex.h"
+#include "InteractableCellData.generated.h"
+
+class UFPP_InteractableComponent;
+class ULevel;
+
+/**
+ * Interactables of a level with their spatial index, built when the level is saved or cooked and stored
+ * in the level as asset user data. With World Partition every streamed cell is a level, so a cell is linked
+ * to the registry of the world in one step when it streams in, instead of registering every interactable.
+ */
+UCLASS()
+class FPP_INTERACTION_API UInteractableCellData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FSpatialCellIndex Index;
+
+	// Interactables of the level, in the order of the index
+	UPROPERTY()
+	TArray<TObjectPtr<UFPP_InteractableComponent>> Components;
+
+	// Tags of the interaction config of every interactable, in the order of the index
+	UPROPERTY()
+	TArray<FGameplayTagContainer> Tags;
+
+#if WITH_EDITOR
+	/**
+	 * Builds the cell data of a level from its interactables, or removes it if there is none.
+	 * The interactables get their index in the cell data, saved with them.
+	 *
+	 * @param Level The level being saved.
+	 */
+	static void BuildForLevel(ULevel* Level);
+#endif
+};
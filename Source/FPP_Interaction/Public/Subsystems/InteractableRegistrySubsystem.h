@@ -0,0 +1,127 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "SpatialHashGrid.h"
+#include "LinkedCellRegistry.h"
+#include "ViewConeFilter.h"
+#include "Subsystems/InteractableCellData.h"
+#include "InteractableRegistrySubsystem.generated.h"
+
+class UFPP_InteractableComponent;
+class ULevel;
+
+/**
+ * Spatial index of the interactables of the world.
+ * The interactables register themselves when they begin play, and the AI interactors query them by radius
+ * and tags on demand instead of sweeping the scene, so the cost only depends on the queries done.
+ * The interactables of a level with cell data (see UInteractableCellData) are not registered one by one:
+ * the whole level is linked when its first interactable begins play, and unlinked when it is removed.
+ */
+UCLASS()
+class FPP_INTERACTION_API UInteractableRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Adds an interactable to the index.
+	 *
+	 * @param Interactable The interactable component.
+	 * @param Location World location of the interactable.
+	 */
+	void RegisterInteractable(UFPP_InteractableComponent* Interactable, const FVector& Location);
+
+	/**
+	 * Removes an interactable from the index.
+	 *
+	 * @param Interactable The interactable component.
+	 * @param Location World location used to register the interactable.
+	 */
+	void UnregisterInteractable(UFPP_InteractableComponent* Interactable, const FVector& Location);
+
+	/**
+	 * Links the cell data of the level of an interactable, if it is not linked yet.
+	 *
+	 * @param Level The level of the interactable.
+	 * @param Interactable The interactable beginning play.
+	 * @param CellEntryIndex Index of the interactable in the cell data of the level.
+	 * @return True if the interactable is in the linked cell data at its current location and doesn't need to be registered.
+	 */
+	bool LinkCell(ULevel* Level, const UFPP_InteractableComponent* Interactable, int32 CellEntryIndex);
+
+	// Removes an interactable from the linked cell data of its level, e.g. when it is destroyed or moved
+	void DetachFromCell(const ULevel* Level, int32 CellEntryIndex);
+
+	// Moves a registered interactable to a new location
+	void MoveInteractable(UFPP_InteractableComponent* Interactable, const FVector& OldLocation, const FVector& NewLocation);
+
+	/**
+	 * Finds the closest interactable having all the required tags.
+	 *
+	 * @param Origin Center of the search.
+	 * @param Radius Maximum distance of the interactable.
+	 * @param RequiredTags Tags the interaction config of the interactable must have. Empty accepts any interactable.
+	 * @param IgnoredActor Actor whose interactables are skipped, usually the one searching.
+	 * @return The closest interactable, or nullptr if none matches.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	UFPP_InteractableComponent* FindNearestInteractable(const FVector& Origin, float Radius, const FGameplayTagContainer& RequiredTags, const AActor* IgnoredActor = nullptr) const;
+
+	/**
+	 * Finds all the interactables having all the required tags, sorted by distance.
+	 *
+	 * @param Origin Center of the search.
+	 * @param Radius Maximum distance of the interactables.
+	 * @param RequiredTags Tags the interaction config of the interactables must have. Empty accepts any interactable.
+	 * @param OutInteractables The interactables found, the closest first.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void QueryInteractables(const FVector& Origin, float Radius, const FGameplayTagContainer& RequiredTags, TArray<UFPP_InteractableComponent*>& OutInteractables) const;
+
+	/**
+	 * Finds the interactables that may be seen in a view cone, the most centered first.
+	 * The positions gathered from the grids are tested four at a time, so the viewer can skip or
+	 * narrow its physics queries.
+	 *
+	 * @param Cone The view cone of the viewer.
+	 * @param CandidateRadius Radius around the location of every interactable, for the parts of the actors far from it.
+	 * @param OutInteractables The interactables in the cone, ranked by alignment with its direction.
+	 */
+	void QueryInViewCone(const FViewCone& Cone, float CandidateRadius, TArray<UFPP_InteractableComponent*>& OutInteractables) const;
+
+	// Returns the number of interactables registered one by one
+	FORCEINLINE int32 GetNumInteractables() const { return Interactables.Num(); }
+
+	// Returns the number of levels whose cell data is linked
+	FORCEINLINE int32 GetNumLinkedCells() const { return LinkedCells.Num(); }
+
+	// Size of the cells of the grids, also used to build the cell data
+	static float GetCellSize();
+
+private:
+	struct FInteractableEntry
+	{
+		TWeakObjectPtr<UFPP_InteractableComponent> Component;
+
+		// Copy of the tags of the interaction config, so the queries don't read the components
+		FGameplayTagContainer Tags;
+
+		bool operator==(const FInteractableEntry& Other) const { return Component == Other.Component; }
+	};
+
+	TSpatialHashGrid<FInteractableEntry> Interactables;
+
+	TLinkedCellRegistry<UInteractableCellData> LinkedCells;
+
+	// Scratch buffers of the view cone queries, kept to avoid allocations
+	mutable FViewConeCandidates ConeCandidates;
+	mutable TArray<UFPP_InteractableComponent*> ConeComponents;
+	mutable TArray<int32> ConeIndices;
+};
@@ -0,0 +1,127 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/HitResult.h"
+#include "GameplayTagContainer.h"
+#include "InteractionEventSubsystem.generated.h"
+
+class UFPP_InteractableComponent;
+class UFPP_InteractorComponent;
+class UInputAction;
+class UInteractionEventSubsystem;
+
+UENUM(BlueprintType)
+enum class EInteractionEventType : uint8
+{
+	FocusGained UMETA(DisplayName = "Focus Gained"),
+	FocusLost UMETA(DisplayName = "Focus Lost"),
+	Interacted UMETA(DisplayName = "Interacted")
+};
+
+/**
+ * Focus or interaction recorded during the frame and delivered with the others at the end of it.
+ */
+struct FInteractionEvent
+{
+	EInteractionEventType Type = EInteractionEventType::FocusGained;
+	TWeakObjectPtr<UFPP_InteractableComponent> Interactable;
+	TWeakObjectPtr<UFPP_InteractorComponent> Interactor;
+	TWeakObjectPtr<const UInputAction> InputAction;
+
+	// Tags of the interaction config of the interactable, used as channels
+	FGameplayTagContainer Tags;
+
+	// Hit of the interaction, only set for Interacted
+	FHitResult Hit;
+
+	// Platform time of the input that caused an Interacted event, 0 if it didn't come from an input
+	double InputSeconds = 0.0;
+
+	// Key of the predicted interaction that caused an Interacted event, 0 if it wasn't predicted
+	uint16 PredictionKey = 0;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnInteractionEvent, const FInteractionEvent&);
+
+// Tick function delivering the events of the frame
+USTRUCT()
+struct FInteractionEventTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UInteractionEventSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("FInteractionEventTickFunction"); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FInteractionEventTickFunction> : public TStructOpsTypeTraitsBase2<FInteractionEventTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Event bus of the interactions of the world.
+ * The interactables record their focus changes and interactions instead of broadcasting them in the middle of
+ * the detection or the input handling, and the events of the frame are delivered in one batch from a tick
+ * function in TG_PostUpdateWork: first to the native listeners of the matching channels, then to the
+ * Blueprint delegates of the interactables.
+ */
+UCLASS()
+class FPP_INTERACTION_API UInteractionEventSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Records an event, delivered with the others of the frame.
+	 *
+	 * @param Event The event.
+	 */
+	void PostEvent(FInteractionEvent&& Event);
+
+	/**
+	 * Subscribes a native listener to the events of a channel.
+	 *
+	 * @param Channel Tag the interactables must have, children included. An empty tag listens to every event.
+	 * @param Delegate The listener.
+	 * @return Handle to unsubscribe.
+	 */
+	FDelegateHandle Subscribe(FGameplayTag Channel, FOnInteractionEvent::FDelegate&& Delegate);
+
+	// Removes a listener added with Subscribe
+	void Unsubscribe(FGameplayTag Channel, FDelegateHandle Handle);
+
+	// Checks if the events are delivered at the end of the frame, false until the world begins play
+	bool IsDeferring() const;
+
+	// Delivers the recorded events
+	void DispatchEvents();
+
+	FORCEINLINE int32 GetNumPendingEvents() const { return PendingEvents.Num(); }
+
+private:
+	// Swaps the buffers and delivers the events to the listeners and the interactables
+	void DeliverPendingEvents();
+
+	// Events recorded this frame, swapped with DispatchingEvents when they are delivered
+	TArray<FInteractionEvent> PendingEvents;
+	TArray<FInteractionEvent> DispatchingEvents;
+
+	TMap<FGameplayTag, FOnInteractionEvent> Channels;
+
+	// Listeners of new channels subscribed during a dispatch, added once it is done
+	TArray<TPair<FGameplayTag, FOnInteractionEvent::FDelegate>> PendingSubscriptions;
+
+	bool bDispatching = false;
+
+	FInteractionEventTickFunction TickFunction;
+};
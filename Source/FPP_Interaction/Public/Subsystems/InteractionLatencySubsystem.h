@@ -0,0 +1,69 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LatencyHistogram.h"
+#include "InteractionLatencySubsystem.generated.h"
+
+// Steps of the path from the interaction input to its effect
+UENUM()
+enum class EInteractionLatency : uint8
+{
+	// Age of the focus detection when the input is pressed, up to DetectionFrequency
+	FocusAge,
+	// Input pressed with nothing focused until the detection focuses the interactable,
+	// only measured while the interaction actions are mapped with nothing focused
+	InputToFocus,
+	// Input pressed until the interactable receives the interaction, deferred events included.
+	// For the interactions of clients without prediction, until the answer of the server
+	InputToEffect,
+	Num UMETA(Hidden)
+};
+
+/**
+ * Measures the latency of the interactions of the local players, in fixed bucket histograms per interactable class.
+ * The interactor timestamps the inputs and the focus detections, the interactable the delivery of the interaction.
+ *
+ * FPP.Interaction.Latency.Dump logs the percentiles, FPP.Interaction.Latency.Csv [Path] writes them to a CSV file
+ * (Saved/Profiling/InteractionLatency by default) and FPP.Interaction.Latency.Reset clears them.
+ * Used to tune the DetectionFrequency of the interactors with real latencies.
+ */
+UCLASS()
+class FPP_INTERACTION_API UInteractionLatencySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Checks the FPP.Interaction.Latency console variable
+	static bool IsEnabled();
+
+	/**
+	 * Adds a latency to the histogram of the class of an interactable.
+	 *
+	 * @param Latency The step measured.
+	 * @param InteractableClass Class of the actor owning the interactable.
+	 * @param Seconds The latency in seconds.
+	 */
+	void Record(EInteractionLatency Latency, const UClass* InteractableClass, double Seconds);
+
+	// Logs the percentiles of every class and step
+	void DumpToLog() const;
+
+	/**
+	 * Writes the percentiles of every class and step to a CSV file.
+	 *
+	 * @param Path Path of the file.
+	 * @return True if the file was written.
+	 */
+	bool WriteCsv(const FString& Path) const;
+
+	void Reset();
+
+private:
+	using FLatencyHistograms = TStaticArray<FLatencyHistogram, static_cast<int32>(EInteractionLatency::Num)>;
+
+	// Histograms per name of interactable class
+	TMap<FName, FLatencyHistograms> Latencies;
+};
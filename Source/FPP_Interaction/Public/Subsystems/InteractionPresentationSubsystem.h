@@ -0,0 +1,73 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "Tickable.h"
+#include "InteractionPresentationSubsystem.generated.h"
+
+class UFPP_InteractableComponent;
+class UInteractionPromptWidget;
+class UPrimitiveComponent;
+
+/**
+ * Presents the focus of the local player without any UI object on the interactables.
+ * The focused primitive renders in custom depth with a stencil value, read by a single post process outline
+ * material, and one prompt widget per local player is moved over it. The subsystem only ticks while
+ * something is focused, and the prompt is collapsed otherwise.
+ */
+UCLASS(config=Game)
+class FPP_INTERACTION_API UInteractionPresentationSubsystem : public ULocalPlayerSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override { return ETickableTickType::Conditional; }
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Highlights an interactable and shows the prompt over it.
+	 *
+	 * @param Interactable The focused interactable.
+	 * @param Primitive The primitive to highlight, usually the one hit by the detection.
+	 */
+	void SetFocus(UFPP_InteractableComponent* Interactable, UPrimitiveComponent* Primitive);
+
+	// Removes the highlight and hides the prompt
+	void ClearFocus();
+
+	// Class of the prompt widget, no prompt is shown if not set
+	UPROPERTY(Config)
+	TSoftClassPtr<UInteractionPromptWidget> PromptWidgetClass;
+
+	// Stencil value written by the focused primitive, the outline post process material tests it
+	UPROPERTY(Config)
+	int32 FocusStencilValue = 252;
+
+	// Height of the prompt above the bounds of the focused primitive
+	UPROPERTY(Config)
+	float PromptHeightOffset = 10.0f;
+
+private:
+	// Places the prompt over the focused primitive, hidden if it is off screen
+	void UpdatePromptPosition();
+
+	// Returns the prompt of the current player controller, created if needed
+	UInteractionPromptWidget* GetOrCreatePrompt();
+
+	TWeakObjectPtr<UFPP_InteractableComponent> FocusedInteractable;
+	TWeakObjectPtr<UPrimitiveComponent> FocusedPrimitive;
+
+	// Custom depth settings of the focused primitive before the highlight, restored when it loses focus
+	bool bPreviousRenderCustomDepth = false;
+	int32 PreviousStencilValue = 0;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UInteractionPromptWidget> Prompt;
+};
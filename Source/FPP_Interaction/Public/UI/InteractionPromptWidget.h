@@ -0,0 +1,28 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "InteractionPromptWidget.generated.h"
+
+class UFPP_InteractableComponent;
+
+/**
+ * Base class of the interaction prompt. A single instance per local player is created by the
+ * UInteractionPresentationSubsystem and moved over the focused interactable, it is collapsed otherwise.
+ */
+UCLASS(Abstract, Blueprintable)
+class FPP_INTERACTION_API UInteractionPromptWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called when the prompt is shown for a new interactable, to update its texts and icons.
+	 *
+	 * @param Interactable The focused interactable.
+	 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Interaction")
+	void OnPromptTargetChanged(UFPP_InteractableComponent* Interactable);
+};
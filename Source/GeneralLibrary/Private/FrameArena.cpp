@@ -0,0 +1,130 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "FrameArena.h"
+
+LLM_DEFINE_TAG(FrameArena);
+
+FFrameArena& FFrameArena::Get()
+{
+	static thread_local FFrameArena Arena;
+	return Arena;
+}
+
+FFrameArena::~FFrameArena()
+{
+	for (const FBlock& Block : Blocks)
+	{
+		FMemory::Free(Block.Data);
+	}
+}
+
+void* FFrameArena::Allocate(SIZE_T Size, uint32 Alignment)
+{
+	ensureMsgf(ScopeDepth > 0 || IsInGameThread(), TEXT("The frame arena is only reset on the game thread, use a FFrameArenaScope on the other threads."));
+	Alignment = FMath::Max<uint32>(Alignment, MinAlignment);
+
+	uint8* Result = Align(Top, Alignment);
+	if (!Top || Result + Size > End)
+	{
+		NextBlock(Size, Alignment);
+		Result = Align(Top, Alignment);
+	}
+
+	UsedBytes += (Result + Size) - Top;
+	Top = Result + Size;
+	LastAllocation = Result;
+	return Result;
+}
+
+void* FFrameArena::Reallocate(void* Old, SIZE_T BytesToKeep, SIZE_T NewSize, uint32 Alignment)
+{
+	// The last allocation only has free memory after it, it can grow or shrink where it is
+	Alignment = FMath::Max<uint32>(Alignment, MinAlignment);
+	uint8* OldData = static_cast<uint8*>(Old);
+	if (OldData && OldData == LastAllocation && IsAligned(OldData, Alignment) && OldData + NewSize <= End)
+	{
+		UsedBytes = UsedBytes - (Top - OldData) + NewSize;
+		Top = OldData + NewSize;
+		return Old;
+	}
+
+	void* Result = Allocate(NewSize, Alignment);
+	if (Old && BytesToKeep > 0)
+	{
+		FMemory::Memcpy(Result, Old, FMath::Min(BytesToKeep, NewSize));
+	}
+	return Result;
+}
+
+void FFrameArena::NextBlock(SIZE_T Size, uint32 Alignment)
+{
+	const SIZE_T Needed = Size + Alignment;
+
+	// The blocks of the previous frames are used again, a block too small for the allocation is skipped
+	while (++CurrentBlock < Blocks.Num())
+	{
+		if (Blocks[CurrentBlock].Size >= Needed)
+		{
+			Top = Blocks[CurrentBlock].Data;
+			End = Top + Blocks[CurrentBlock].Size;
+			return;
+		}
+	}
+
+	LLM_SCOPE_BYTAG(FrameArena);
+	FBlock& Block = Blocks.AddDefaulted_GetRef();
+	Block.Size = FMath::Max(DefaultBlockSize, Align(Needed, DefaultBlockSize));
+	Block.Data = static_cast<uint8*>(FMemory::Malloc(Block.Size, 16));
+	CurrentBlock = Blocks.Num() - 1;
+	Top = Block.Data;
+	End = Top + Block.Size;
+}
+
+void FFrameArena::Reset()
+{
+	CurrentBlock = Blocks.IsEmpty() ? INDEX_NONE : 0;
+	Top = Blocks.IsEmpty() ? nullptr : Blocks[0].Data;
+	End = Blocks.IsEmpty() ? nullptr : Top + Blocks[0].Size;
+	LastAllocation = nullptr;
+	UsedBytes = 0;
+}
+
+SIZE_T FFrameArena::GetReservedBytes() const
+{
+	SIZE_T Bytes = 0;
+	for (const FBlock& Block : Blocks)
+	{
+		Bytes += Block.Size;
+	}
+	return Bytes;
+}
+
+void FFrameArena::EndFrame()
+{
+	check(IsInGameThread());
+
+	FFrameArena& Arena = Get();
+	if (Arena.ScopeDepth == 0)
+	{
+		Arena.Reset();
+	}
+}
+
+FFrameArenaScope::FFrameArenaScope()
+	: Arena(FFrameArena::Get())
+{
+	Mark.Block = Arena.CurrentBlock;
+	Mark.Top = Arena.Top;
+	Mark.UsedBytes = Arena.UsedBytes;
+	++Arena.ScopeDepth;
+}
+
+FFrameArenaScope::~FFrameArenaScope()
+{
+	--Arena.ScopeDepth;
+	Arena.CurrentBlock = Mark.Block;
+	Arena.Top = Mark.Top;
+	Arena.End = Mark.Block != INDEX_NONE ? Arena.Blocks[Mark.Block].Data + Arena.Blocks[Mark.Block].Size : nullptr;
+	Arena.UsedBytes = Mark.UsedBytes;
+	Arena.LastAllocation = nullptr;
+}
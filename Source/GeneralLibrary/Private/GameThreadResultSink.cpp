@@ -0,0 +1,71 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "GameThreadResultSink.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+
+void FGameThreadResultSinkTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Sink)
+	{
+		Sink->Drain();
+	}
+}
+
+FGameThreadResultSinkBase::~FGameThreadResultSinkBase()
+{
+	Unregister();
+}
+
+void FGameThreadResultSinkBase::Register(UWorld* World, ETickingGroup TickGroup, double InBudgetSeconds, int32 InBatchSize)
+{
+	check(IsInGameThread());
+	Unregister();
+
+	BudgetSeconds = InBudgetSeconds;
+	BatchSize = FMath::Max(InBatchSize, 1);
+	if (!World || !World->PersistentLevel)
+	{
+		return;
+	}
+
+	TickFunction.Sink = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bStartWithTickEnabled = true;
+	TickFunction.bTickEvenWhenPaused = false;
+	TickFunction.TickGroup = TickGroup;
+	TickFunction.RegisterTickFunction(World->PersistentLevel);
+}
+
+void FGameThreadResultSinkBase::Unregister()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+	TickFunction.Sink = nullptr;
+}
+
+int32 FGameThreadResultSinkBase::Drain()
+{
+	check(IsInGameThread());
+
+	// The budget is checked between batches, so a frame always makes progress
+	const double Deadline = FPlatformTime::Seconds() + BudgetSeconds;
+	int32 Handled = 0;
+	int32 BatchHandled;
+	do
+	{
+		BatchHandled = DrainBatch(BatchSize);
+		Handled += BatchHandled;
+	}
+	while (BatchHandled == BatchSize && (BudgetSeconds <= 0.0 || FPlatformTime::Seconds() < Deadline));
+
+	return Handled;
+}
+
+int32 FGameThreadResultSinkBase::DrainAll()
+{
+	check(IsInGameThread());
+	return DrainBatch(MAX_int32);
+}
@@ -0,0 +1,32 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "GameplayPerfTracker.h"
+
+FGameplayPerfTracker& FGameplayPerfTracker::Get()
+{
+	static FGameplayPerfTracker Instance;
+	return Instance;
+}
+
+void FGameplayPerfTracker::SetEnabled(bool bInEnabled)
+{
+	check(IsInGameThread());
+
+	if (bInEnabled && !IsEnabled())
+	{
+		Reset();
+	}
+	bEnabled.store(bInEnabled, std::memory_order_relaxed);
+}
+
+void FGameplayPerfTracker::AddScopeTime(FName ScopeName, uint64 Cycles)
+{
+	FScopeStats& Stats = ScopeStats.FindOrAdd(ScopeName);
+	Stats.Cycles += Cycles;
+	++Stats.Calls;
+}
+
+void FGameplayPerfTracker::Reset()
+{
+	ScopeStats.Reset();
+}
@@ -1,15 +1,18 @@
 ﻿#include "GeneralLibrary.h"
+#include "FrameArena.h"
+#include "Misc/CoreDelegates.h"
 
 #define LOCTEXT_NAMESPACE "FGeneralLibraryModule"
 
 void FGeneralLibraryModule::StartupModule()
 {
-    
+    // The temporaries of the frame are released at once when it ends
+    EndFrameHandle = FCoreDelegates::OnEndFrame.AddStatic(&FFrameArena::EndFrame);
 }
 
 void FGeneralLibraryModule::ShutdownModule()
 {
-    
+    FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
 }
 
 #undef LOCTEXT_NAMESPACE
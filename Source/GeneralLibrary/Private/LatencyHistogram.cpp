@@ -0,0 +1,60 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "LatencyHistogram.h"
+
+void FLatencyHistogram::Add(double LatencyMs)
+{
+	LatencyMs = FMath::Max(LatencyMs, 0.0);
+
+	// Index of the first bucket whose upper bound is over the latency
+	int32 Bucket = 0;
+	if (LatencyMs > FirstBucketMs)
+	{
+		Bucket = FMath::CeilToInt32(FMath::Loge(LatencyMs / FirstBucketMs) / FMath::Loge(BucketGrowth));
+		Bucket = FMath::Clamp(Bucket, 0, NumBuckets - 1);
+	}
+
+	++Buckets[Bucket];
+	++Count;
+	SumMs += LatencyMs;
+	MaxMs = FMath::Max(MaxMs, LatencyMs);
+}
+
+void FLatencyHistogram::Reset()
+{
+	*this = FLatencyHistogram();
+}
+
+double FLatencyHistogram::GetPercentile(double Percent) const
+{
+	if (Count == 0)
+	{
+		return 0.0;
+	}
+
+	const double Rank = FMath::Clamp(Percent, 0.0, 1.0) * Count;
+	uint64 Accumulated = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		if (Buckets[Bucket] == 0)
+		{
+			continue;
+		}
+
+		const uint64 Next = Accumulated + Buckets[Bucket];
+		if (Next >= Rank)
+		{
+			const double LowerBound = Bucket > 0 ? GetBucketUpperBound(Bucket - 1) : 0.0;
+			const double UpperBound = FMath::Min(GetBucketUpperBound(Bucket), MaxMs);
+			const double Alpha = (Rank - Accumulated) / Buckets[Bucket];
+			return FMath::Lerp(LowerBound, FMath::Max(UpperBound, LowerBound), Alpha);
+		}
+		Accumulated = Next;
+	}
+	return MaxMs;
+}
+
+double FLatencyHistogram::GetBucketUpperBound(int32 Bucket)
+{
+	return FirstBucketMs * FMath::Pow(BucketGrowth, static_cast<double>(Bucket));
+}
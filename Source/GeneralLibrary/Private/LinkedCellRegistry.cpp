@@ -0,0 +1,48 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "LinkedCellRegistry.h"
+
+#if WITH_EDITOR
+#include "Misc/DelayedAutoRegister.h"
+#include "UObject/ObjectSaveContext.h"
+
+FCellDataBuilder::FCellDataBuilder(FBuildFunction InBuildFunction)
+	: BuildFunction(InBuildFunction)
+{
+	GetBuilders().Add(this);
+}
+
+FCellDataBuilder::~FCellDataBuilder()
+{
+	GetBuilders().RemoveSingleSwap(this);
+}
+
+TArray<FCellDataBuilder*>& FCellDataBuilder::GetBuilders()
+{
+	// Filled by static objects of other modules, so it must exist before them
+	static TArray<FCellDataBuilder*> Builders;
+	return Builders;
+}
+
+void FCellDataBuilder::BuildAll(ULevel* Level)
+{
+	for (const FCellDataBuilder* Builder : GetBuilders())
+	{
+		Builder->BuildFunction(Level);
+	}
+}
+
+static void HandleObjectPreSave(UObject* Object, FObjectPreSaveContext SaveContext)
+{
+	UWorld* World = Cast<UWorld>(Object);
+	if (World && World->PersistentLevel && (SaveContext.IsCooking() || !World->IsPartitionedWorld()))
+	{
+		FCellDataBuilder::BuildAll(World->PersistentLevel);
+	}
+}
+
+static FDelayedAutoRegisterHelper GCellDataBuilderRegister(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+{
+	FCoreUObjectDelegates::OnObjectPreSave.AddStatic(&HandleObjectPreSave);
+});
+#endif
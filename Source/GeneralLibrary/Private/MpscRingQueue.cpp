@@ -0,0 +1,79 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "MpscRingQueue.h"
+#include "UtilsLib.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+
+/**
+ * Measures the throughput of the queue with 1 to 16 producer threads pushing to the calling thread.
+ * The producers retry when the queue is full, the retries show how often the consumer is the bottleneck.
+ * Usage: GenLib.MpscQueue.Bench [ItemsPerProducer=100000] [Capacity=1024]
+ */
+static void MpscQueueBench(const TArray<FString>& Args)
+{
+	const int32 ItemsPerProducer = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100000;
+	const int32 Capacity = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 2) : 1024;
+
+	for (const int32 NumProducers : { 1, 2, 4, 8, 16 })
+	{
+		TMpscRingQueue<uint64> Queue(Capacity);
+		std::atomic<bool> bStart{false};
+		std::atomic<uint64> FullRetries{0};
+
+		TArray<TFuture<void>> Producers;
+		for (int32 Producer = 0; Producer < NumProducers; ++Producer)
+		{
+			Producers.Add(Async(EAsyncExecution::Thread, [&Queue, &bStart, &FullRetries, ItemsPerProducer]()
+			{
+				while (!bStart.load(std::memory_order_acquire))
+				{
+					FPlatformProcess::YieldThread();
+				}
+
+				uint64 Retries = 0;
+				for (int32 Item = 1; Item <= ItemsPerProducer; ++Item)
+				{
+					while (!Queue.TryPush(static_cast<uint64>(Item)))
+					{
+						++Retries;
+						FPlatformProcess::YieldThread();
+					}
+				}
+				FullRetries.fetch_add(Retries, std::memory_order_relaxed);
+			}));
+		}
+
+		const int64 Expected = static_cast<int64>(NumProducers) * ItemsPerProducer;
+		int64 Received = 0;
+		uint64 Sum = 0;
+		const double Start = FPlatformTime::Seconds();
+		bStart.store(true, std::memory_order_release);
+		while (Received < Expected)
+		{
+			const int32 Drained = Queue.Drain([&Sum](uint64&& Item) { Sum += Item; }, 64);
+			if (Drained == 0)
+			{
+				FPlatformProcess::YieldThread();
+			}
+			Received += Drained;
+		}
+		const double Seconds = FPlatformTime::Seconds() - Start;
+
+		for (TFuture<void>& Producer : Producers)
+		{
+			Producer.Wait();
+		}
+
+		// Every producer pushed 1..N, so nothing was lost or duplicated if the sum matches
+		const uint64 ExpectedSum = static_cast<uint64>(NumProducers) * ItemsPerProducer * (static_cast<uint64>(ItemsPerProducer) + 1) / 2;
+		UE_LOG(LogUtilLib, Display, TEXT("MPSC queue %2d producers: %.2f M items/s, %.1f ns per item, %llu full retries, %s."),
+			NumProducers, Expected / FMath::Max(Seconds, UE_SMALL_NUMBER) / 1e6, Seconds * 1e9 / Expected, FullRetries.load(),
+			Sum == ExpectedSum ? TEXT("checksum ok") : TEXT("CHECKSUM MISMATCH"));
+	}
+}
+
+static FAutoConsoleCommandWithArgs MpscQueueBenchCommand(
+	TEXT("GenLib.MpscQueue.Bench"),
+	TEXT("Measures the MPSC ring queue with 1, 2, 4, 8 and 16 producers. Usage: GenLib.MpscQueue.Bench [ItemsPerProducer=100000] [Capacity=1024]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&MpscQueueBench));
@@ -0,0 +1,42 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "SpatialCellIndex.h"
+
+void FSpatialCellIndex::Build(TConstArrayView<FVector> InLocations, float InCellSize, TArray<int32>& OutOrder)
+{
+	Reset();
+	CellSize = FMath::Max(InCellSize, 1.0f);
+
+	TArray<FIntPoint> Cells;
+	Cells.Reserve(InLocations.Num());
+	OutOrder.Reset(InLocations.Num());
+	for (int32 Index = 0; Index < InLocations.Num(); ++Index)
+	{
+		Cells.Add(GetCell(InLocations[Index]));
+		OutOrder.Add(Index);
+	}
+
+	// Stable so the order inside a cell doesn't change between two builds of the same level
+	OutOrder.StableSort([&Cells](int32 A, int32 B)
+	{
+		return Cells[A].X != Cells[B].X ? Cells[A].X < Cells[B].X : Cells[A].Y < Cells[B].Y;
+	});
+
+	Locations.Reserve(OutOrder.Num());
+	for (int32 SortedIndex = 0; SortedIndex < OutOrder.Num(); ++SortedIndex)
+	{
+		const int32 SourceIndex = OutOrder[SortedIndex];
+		Locations.Add(InLocations[SourceIndex]);
+		Bounds += InLocations[SourceIndex];
+
+		FIntPoint& Range = CellRanges.FindOrAdd(Cells[SourceIndex], FIntPoint(SortedIndex, 0));
+		++Range.Y;
+	}
+}
+
+void FSpatialCellIndex::Reset()
+{
+	Bounds = FBox(ForceInit);
+	Locations.Reset();
+	CellRanges.Reset();
+}
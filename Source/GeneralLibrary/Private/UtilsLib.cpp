@@ -4,6 +4,7 @@
 #include "UtilsLib.h"
 
 #include "GeneralLibrary.h"
+#include "GameplayPerfTracker.h"
 #include "Camera/CameraComponent.h"
 
 // Define the custom log category for this class
@@ -11,8 +12,10 @@ DEFINE_LOG_CATEGORY(LogUtilLib);
 
 bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirection TraceDirection,
 	ETraceStartPoint StartFrom, FVector StartOffset, float TraceDistance, float Size,
-	EDrawDebugTrace::Type DrawDebugType, ECollisionChannel TraceChannel, TArray<FHitResult>& OutHitResults)
+	EDrawDebugTrace::Type DrawDebugType, ECollisionChannel TraceChannel, TArray<FHitResult>& OutHitResults, float CapsuleHalfHeight)
 	{
+		GENLIB_PERF_SCOPE("TraceFromActor");
+
 		// Validate Actor parameter
 		if (!Actor)
 		{
@@ -31,12 +34,15 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 		// Trace start and end
 		FVector TraceStart, TraceEnd;
 		FVector DirectionVector;
+		// Rotation of the trace source, used to orient the capsule
+		FQuat SourceRotation = FQuat::Identity;
 
 		// Determine the starting point
 		// Determine the starting point based on StartFrom enum
 		if (StartFrom == ETraceStartPoint::PlayerCenter)
 		{
 			TraceStart = Actor->GetActorLocation() + StartOffset;
+			SourceRotation = Actor->GetActorQuat();
 			// Calculate TraceEnd based on TraceDirection enum
 			
 			switch (static_cast<int>(TraceDirection))
@@ -71,6 +77,7 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 			if (CameraComponent)
 			{
 				TraceStart = CameraComponent->GetComponentLocation() + StartOffset;
+				SourceRotation = CameraComponent->GetComponentQuat();
 				// Calculate TraceEnd based on TraceDirection enum
 				switch (static_cast<int>(TraceDirection))
 				{
@@ -107,6 +114,9 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 
 		TraceEnd = TraceStart + (DirectionVector * TraceDistance);
 
+		// The capsule stands along the up axis of the source, never shorter than a sphere of the same radius
+		const float CapsuleTraceHalfHeight = FMath::Max(CapsuleHalfHeight, Size);
+
 		
 		// Collision Query Parameters
 		FCollisionQueryParams QueryParams;
@@ -138,9 +148,9 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 				OutHitResults,
 				TraceStart,
 				TraceEnd,
-				FQuat::Identity,
+				SourceRotation,
 				TraceChannel,
-				FCollisionShape::MakeCapsule(Size, TraceDistance * 0.5f), // Size is the radius, TraceDistance * 0.5f is height
+				FCollisionShape::MakeCapsule(Size, CapsuleTraceHalfHeight), // Size is the radius
 				QueryParams
 			);
 			break;
@@ -166,8 +176,8 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 			}
 			else if (TraceType == ETraceType::Capsule)
 			{
-				DrawDebugCapsule(World, TraceStart, TraceDistance * 0.5f, Size, FQuat::Identity, FColor::Blue, bPersistent, 1.0f);
-				DrawDebugCapsule(World, TraceEnd, TraceDistance * 0.5f, Size, FQuat::Identity, FColor::Blue, bPersistent, 1.0f);
+				DrawDebugCapsule(World, TraceStart, CapsuleTraceHalfHeight, Size, SourceRotation, FColor::Blue, bPersistent, 1.0f);
+				DrawDebugCapsule(World, TraceEnd, CapsuleTraceHalfHeight, Size, SourceRotation, FColor::Blue, bPersistent, 1.0f);
 			}
 
 			// Highlight hit points
@@ -179,3 +189,35 @@ bool UUtilsLib::TraceFromActor(AActor* Actor, ETraceType TraceType, ETraceDirect
 
 		return bHit && OutHitResults.Num() > 0;
 	}
+
+bool UUtilsLib::SweepCapsuleBetweenSegments(const UWorld* World, const FVector& StartBase, const FVector& StartTip,
+	const FVector& EndBase, const FVector& EndTip, float Radius, ECollisionChannel TraceChannel,
+	const FCollisionQueryParams& QueryParams, TArray<FHitResult>& OutHitResults)
+{
+	if (!World)
+	{
+		UE_LOG(LogUtilLib, Error, TEXT("SweepCapsuleBetweenSegments: World is nullptr. %s"), *GENLIB_LOGS_LINE);
+		return false;
+	}
+
+	const FVector StartAxis = StartTip - StartBase;
+	const FVector EndAxis = EndTip - EndBase;
+
+	// A capsule is aligned with its Z axis, built from the mean axis so the two ends don't add a twist.
+	// Degenerated or opposite segments keep the world up
+	const FVector MeanAxis = (StartAxis.GetSafeNormal() + EndAxis.GetSafeNormal()).GetSafeNormal();
+	const FQuat Rotation = MeanAxis.IsNearlyZero() ? FQuat::Identity : FRotationMatrix::MakeFromZ(MeanAxis).ToQuat();
+
+	// The hemispheres of the capsule cover the ends of the segment
+	const float HalfHeight = FMath::Max(StartAxis.Size(), EndAxis.Size()) * 0.5f + Radius;
+
+	return World->SweepMultiByChannel(
+		OutHitResults,
+		(StartBase + StartTip) * 0.5f,
+		(EndBase + EndTip) * 0.5f,
+		Rotation,
+		TraceChannel,
+		FCollisionShape::MakeCapsule(Radius, HalfHeight),
+		QueryParams
+	);
+}
@@ -0,0 +1,172 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "ViewConeFilter.h"
+#include "UtilsLib.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/VectorRegister.h"
+
+void FViewConeCandidates::Reset()
+{
+	X.Reset();
+	Y.Reset();
+	Z.Reset();
+	Radii.Reset();
+}
+
+void FViewConeCandidates::Reserve(int32 Num)
+{
+	X.Reserve(Num);
+	Y.Reserve(Num);
+	Z.Reserve(Num);
+}
+
+void FViewConeCandidates::Add(const FVector& Location, float Radius)
+{
+	X.Add(Location.X);
+	Y.Add(Location.Y);
+	Z.Add(Location.Z);
+	if (Radius > 0.0f || !Radii.IsEmpty())
+	{
+		// The positions added before without radius are points
+		Radii.SetNumZeroed(X.Num() - 1);
+		Radii.Add(Radius);
+	}
+}
+
+namespace ViewConeFilter
+{
+	// Scalar version of the test, for the positions left after the groups of four
+	static FORCEINLINE bool IsInside(const FViewCone& Cone, float X, float Y, float Z, float Radius)
+	{
+		const float DX = X - Cone.Origin.X;
+		const float DY = Y - Cone.Origin.Y;
+		const float DZ = Z - Cone.Origin.Z;
+		const float DistSquared = DX * DX + DY * DY + DZ * DZ;
+		const float Range = Cone.MaxRange + Radius;
+		const float Along = DX * Cone.Forward.X + DY * Cone.Forward.Y + DZ * Cone.Forward.Z;
+		return DistSquared <= Range * Range && Along + Radius >= Cone.CosHalfAngle * FMath::Sqrt(DistSquared);
+	}
+}
+
+int32 FViewConeFilter::Filter(const FViewCone& Cone, TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z,
+	TConstArrayView<float> Radii, TArray<int32>& OutIndices)
+{
+	const int32 Num = X.Num();
+	check(Y.Num() == Num && Z.Num() == Num);
+	check(Radii.IsEmpty() || Radii.Num() == Num);
+
+	const bool bHasRadii = !Radii.IsEmpty();
+	const int32 StartNum = OutIndices.Num();
+	OutIndices.Reserve(StartNum + Num);
+
+	const VectorRegister4Float OriginX = VectorSetFloat1(Cone.Origin.X);
+	const VectorRegister4Float OriginY = VectorSetFloat1(Cone.Origin.Y);
+	const VectorRegister4Float OriginZ = VectorSetFloat1(Cone.Origin.Z);
+	const VectorRegister4Float ForwardX = VectorSetFloat1(Cone.Forward.X);
+	const VectorRegister4Float ForwardY = VectorSetFloat1(Cone.Forward.Y);
+	const VectorRegister4Float ForwardZ = VectorSetFloat1(Cone.Forward.Z);
+	const VectorRegister4Float CosHalfAngle = VectorSetFloat1(Cone.CosHalfAngle);
+	const VectorRegister4Float MaxRange = VectorSetFloat1(Cone.MaxRange);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		const VectorRegister4Float DX = VectorSubtract(VectorLoad(&X[Index]), OriginX);
+		const VectorRegister4Float DY = VectorSubtract(VectorLoad(&Y[Index]), OriginY);
+		const VectorRegister4Float DZ = VectorSubtract(VectorLoad(&Z[Index]), OriginZ);
+		const VectorRegister4Float Radius = bHasRadii ? VectorLoad(&Radii[Index]) : VectorZeroFloat();
+
+		const VectorRegister4Float DistSquared = VectorMultiplyAdd(DZ, DZ, VectorMultiplyAdd(DY, DY, VectorMultiply(DX, DX)));
+		const VectorRegister4Float Range = VectorAdd(MaxRange, Radius);
+		const VectorRegister4Float Along = VectorMultiplyAdd(DZ, ForwardZ, VectorMultiplyAdd(DY, ForwardY, VectorMultiply(DX, ForwardX)));
+
+		const VectorRegister4Float InRange = VectorCompareLE(DistSquared, VectorMultiply(Range, Range));
+		const VectorRegister4Float InAngle = VectorCompareGE(VectorAdd(Along, Radius), VectorMultiply(CosHalfAngle, VectorSqrt(DistSquared)));
+
+		// One bit per position passing both tests
+		uint32 Mask = static_cast<uint32>(VectorMaskBits(VectorBitwiseAnd(InRange, InAngle)));
+		while (Mask != 0)
+		{
+			OutIndices.Add(Index + FMath::CountTrailingZeros(Mask));
+			Mask &= Mask - 1;
+		}
+	}
+
+	for (; Index < Num; ++Index)
+	{
+		if (ViewConeFilter::IsInside(Cone, X[Index], Y[Index], Z[Index], bHasRadii ? Radii[Index] : 0.0f))
+		{
+			OutIndices.Add(Index);
+		}
+	}
+
+	return OutIndices.Num() - StartNum;
+}
+
+float FViewConeFilter::GetAlignment(const FViewCone& Cone, const FVector& Location)
+{
+	const FVector3f Direction = (FVector3f(Location) - Cone.Origin).GetSafeNormal();
+	return Direction.IsZero() ? 1.0f : FVector3f::DotProduct(Direction, Cone.Forward);
+}
+
+/**
+ * Compares the SIMD filter with a per-position FVector loop, at 1k, 10k and 100k random positions around the origin.
+ * Usage: GenLib.ViewCone.Bench [Iterations=100]
+ */
+static void ViewConeBench(const TArray<FString>& Args)
+{
+	const int32 Iterations = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+	const FViewCone Cone(FVector::ZeroVector, FVector::ForwardVector, 30.0f, 5000.0f);
+
+	for (const int32 NumPoints : { 1000, 10000, 100000 })
+	{
+		FRandomStream Random(NumPoints);
+		FViewConeCandidates Candidates;
+		Candidates.Reserve(NumPoints);
+		TArray<FVector> Locations;
+		Locations.Reserve(NumPoints);
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			const FVector Location = Random.GetUnitVector() * Random.FRandRange(0.0f, 10000.0f);
+			Candidates.Add(Location);
+			Locations.Add(Location);
+		}
+
+		TArray<int32> Indices;
+		Indices.Reserve(NumPoints);
+		const double SimdStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Indices.Reset();
+			FViewConeFilter::Filter(Cone, Candidates, Indices);
+		}
+		const double SimdSeconds = FPlatformTime::Seconds() - SimdStart;
+		const int32 SimdPassed = Indices.Num();
+
+		const FVector Origin(Cone.Origin);
+		const FVector Forward(Cone.Forward);
+		const double ScalarStart = FPlatformTime::Seconds();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Indices.Reset();
+			for (int32 Index = 0; Index < Locations.Num(); ++Index)
+			{
+				const FVector Direction = Locations[Index] - Origin;
+				const double Distance = Direction.Size();
+				if (Distance <= Cone.MaxRange && FVector::DotProduct(Direction, Forward) >= Cone.CosHalfAngle * Distance)
+				{
+					Indices.Add(Index);
+				}
+			}
+		}
+		const double ScalarSeconds = FPlatformTime::Seconds() - ScalarStart;
+
+		UE_LOG(LogUtilLib, Display, TEXT("View cone %d points: SIMD %.1f us (%d inside), scalar %.1f us (%d inside), %.2fx."),
+			NumPoints, SimdSeconds * 1e6 / Iterations, SimdPassed, ScalarSeconds * 1e6 / Iterations, Indices.Num(), ScalarSeconds / FMath::Max(SimdSeconds, UE_SMALL_NUMBER));
+	}
+}
+
+static FAutoConsoleCommandWithArgs ViewConeBenchCommand(
+	TEXT("GenLib.ViewCone.Bench"),
+	TEXT("Measures the SIMD view cone filter against a scalar loop at 1k, 10k and 100k points. Usage: GenLib.ViewCone.Bench [Iterations=100]"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&ViewConeBench));
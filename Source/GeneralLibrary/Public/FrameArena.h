@@ -0,0 +1,232 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Containers/ContainerAllocationPolicies.h"
+
+LLM_DECLARE_TAG_API(FrameArena, GENERALLIBRARY_API);
+
+/**
+ * Bump allocator for the temporaries of a frame, one per thread.
+ * Allocating moves a pointer in a block of memory kept between frames, and nothing is freed one by one:
+ * the arena of the game thread is reset at the end of every frame, so the temporaries growing past their
+ * inline elements don't go to the heap. The other threads must use it inside a FFrameArenaScope.
+ * Memory from the arena must not be kept after the frame (or the scope) it was allocated in.
+ */
+class GENERALLIBRARY_API FFrameArena
+{
+public:
+	// Returns the arena of the calling thread
+	static FFrameArena& Get();
+
+	~FFrameArena();
+
+	/**
+	 * Allocates memory valid until the arena is reset or rewound.
+	 *
+	 * @param Size Bytes to allocate.
+	 * @param Alignment Alignment of the memory, a power of two. At least 16 bytes are used, like FMemory::Malloc.
+	 * @return The memory.
+	 */
+	void* Allocate(SIZE_T Size, uint32 Alignment);
+
+	/**
+	 * Grows an allocation, in place if it is the last one made and the block has room.
+	 *
+	 * @param Old Previous allocation, can be nullptr.
+	 * @param BytesToKeep Bytes of the previous allocation copied to the new one if it moves.
+	 * @param NewSize Bytes of the new allocation.
+	 * @param Alignment Alignment of the memory, a power of two.
+	 * @return The memory, with the kept bytes of the previous allocation.
+	 */
+	void* Reallocate(void* Old, SIZE_T BytesToKeep, SIZE_T NewSize, uint32 Alignment);
+
+	// Releases all the allocations at once, keeping the blocks for the next frame
+	void Reset();
+
+	// Bytes allocated since the last reset, and bytes of the blocks owned by the arena
+	FORCEINLINE SIZE_T GetUsedBytes() const { return UsedBytes; }
+	SIZE_T GetReservedBytes() const;
+
+	// Resets the arena of the game thread, called at the end of every frame
+	static void EndFrame();
+
+private:
+	friend class FFrameArenaScope;
+
+	struct FBlock
+	{
+		uint8* Data = nullptr;
+		SIZE_T Size = 0;
+	};
+
+	struct FMark
+	{
+		int32 Block = INDEX_NONE;
+		uint8* Top = nullptr;
+		SIZE_T UsedBytes = 0;
+	};
+
+	// Moves to the next block with room for an allocation, adding one if needed
+	void NextBlock(SIZE_T Size, uint32 Alignment);
+
+	static constexpr SIZE_T DefaultBlockSize = 64 * 1024;
+
+	// Alignment of the allocations asking for less, or for the default alignment (0), the one of FMemory::Malloc
+	// so the vector types (FTransform, FQuat) are aligned even when the container doesn't pass their alignment
+	static constexpr uint32 MinAlignment = 16;
+
+	TArray<FBlock, TInlineAllocator<4>> Blocks;
+	int32 CurrentBlock = INDEX_NONE;
+	uint8* Top = nullptr;
+	uint8* End = nullptr;
+	void* LastAllocation = nullptr;
+	SIZE_T UsedBytes = 0;
+	int32 ScopeDepth = 0;
+};
+
+/**
+ * Rewinds the arena of the calling thread to where it was when the scope was opened.
+ * Required around the use of the arena on other threads than the game thread, which are not reset every frame.
+ */
+class GENERALLIBRARY_API FFrameArenaScope
+{
+public:
+	FFrameArenaScope();
+	~FFrameArenaScope();
+
+	FFrameArenaScope(const FFrameArenaScope&) = delete;
+	FFrameArenaScope& operator=(const FFrameArenaScope&) = delete;
+
+private:
+	FFrameArena& Arena;
+	FFrameArena::FMark Mark;
+};
+
+/**
+ * Container allocator taking the memory from the frame arena of the calling thread, e.g.
+ * TArray<FHitResult, FFrameArenaAllocator> or TInlineAllocator<8, FFrameArenaAllocator> to only use it past the inline elements.
+ * With an inline allocator the arena is only the spill path of the bursts, the steady state stays in the inline elements.
+ * Freeing does nothing, so the containers must not live past the frame.
+ */
+class FFrameArenaAllocator
+{
+public:
+	using SizeType = int32;
+
+	enum { NeedsElementType = false };
+	enum { RequireRangeCheck = true };
+
+	class ForAnyElementType
+	{
+	public:
+		ForAnyElementType() = default;
+
+		FORCEINLINE void MoveToEmpty(ForAnyElementType& Other)
+		{
+			check(this != &Other);
+			Data = Other.Data;
+			Other.Data = nullptr;
+		}
+
+		FORCEINLINE FScriptContainerElement* GetAllocation() const
+		{
+			return Data;
+		}
+
+		FORCEINLINE void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+		{
+			ResizeAllocation(CurrentNum, NewMax, NumBytesPerElement, DEFAULT_ALIGNMENT);
+		}
+
+		void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement)
+		{
+			if (NewMax == 0)
+			{
+				Data = nullptr;
+				return;
+			}
+
+			Data = static_cast<FScriptContainerElement*>(FFrameArena::Get().Reallocate(Data, CurrentNum * NumBytesPerElement, NewMax * NumBytesPerElement, AlignmentOfElement));
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false);
+		}
+
+		FORCEINLINE SizeType CalculateSlackReserve(SizeType NewMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackReserve(NewMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+
+		FORCEINLINE SizeType CalculateSlackShrink(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackShrink(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false);
+		}
+
+		FORCEINLINE SizeType CalculateSlackGrow(SizeType NewMax, SizeType CurrentMax, SIZE_T NumBytesPerElement, uint32 AlignmentOfElement) const
+		{
+			return DefaultCalculateSlackGrow(NewMax, CurrentMax, NumBytesPerElement, false, AlignmentOfElement);
+		}
+
+		FORCEINLINE SIZE_T GetAllocatedSize(SizeType CurrentMax, SIZE_T NumBytesPerElement) const
+		{
+			return CurrentMax * NumBytesPerElement;
+		}
+
+		FORCEINLINE bool HasAllocation() const
+		{
+			return Data != nullptr;
+		}
+
+		FORCEINLINE SizeType GetInitialCapacity() const
+		{
+			return 0;
+		}
+
+	private:
+		ForAnyElementType(const ForAnyElementType&) = delete;
+		ForAnyElementType& operator=(const ForAnyElementType&) = delete;
+
+		FScriptContainerElement* Data = nullptr;
+	};
+
+	template<typename ElementType>
+	class ForElementType : public ForAnyElementType
+	{
+	public:
+		using ForAnyElementType::ResizeAllocation;
+
+		// TInlineAllocator resizes its secondary allocation without the alignment, it is known here
+		FORCEINLINE void ResizeAllocation(SizeType CurrentNum, SizeType NewMax, SIZE_T NumBytesPerElement)
+		{
+			ForAnyElementType::ResizeAllocation(CurrentNum, NewMax, NumBytesPerElement, alignof(ElementType));
+		}
+
+		FORCEINLINE ElementType* GetAllocation() const
+		{
+			return reinterpret_cast<ElementType*>(ForAnyElementType::GetAllocation());
+		}
+	};
+};
+
+template<>
+struct TAllocatorTraits<FFrameArenaAllocator> : TAllocatorTraitsBase<FFrameArenaAllocator>
+{
+	enum { SupportsMove = true };
+	enum { IsZeroConstruct = true };
+	enum { SupportsElementAlignment = true };
+};
@@ -0,0 +1,131 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "MpscRingQueue.h"
+#include "GameThreadResultSink.generated.h"
+
+class FGameThreadResultSinkBase;
+
+// Tick function draining a result sink
+USTRUCT()
+struct GENERALLIBRARY_API FGameThreadResultSinkTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	FGameThreadResultSinkBase* Sink = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override { return TEXT("FGameThreadResultSinkTickFunction"); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameThreadResultSinkTickFunction> : public TStructOpsTypeTraitsBase2<FGameThreadResultSinkTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Hands the results of asynchronous work back to the game thread.
+ * Any thread pushes its results, and a tick function of the world drains them in batches in the chosen
+ * tick group until the time budget of the frame is spent, the rest waits for the next frame.
+ * The results are typed by TGameThreadResultSink, this base holds the ticking and the budget.
+ */
+class GENERALLIBRARY_API FGameThreadResultSinkBase
+{
+public:
+	FGameThreadResultSinkBase() = default;
+	virtual ~FGameThreadResultSinkBase();
+
+	FGameThreadResultSinkBase(const FGameThreadResultSinkBase&) = delete;
+	FGameThreadResultSinkBase& operator=(const FGameThreadResultSinkBase&) = delete;
+
+	/**
+	 * Starts draining the results every frame of a world.
+	 *
+	 * @param World World ticking the sink.
+	 * @param TickGroup Group the results are handled in.
+	 * @param InBudgetSeconds Time spent handling results per frame, 0 for no limit. At least one batch is handled every frame.
+	 * @param InBatchSize Results handled between two checks of the budget. 1 for results that are expensive to handle.
+	 */
+	void Register(UWorld* World, ETickingGroup TickGroup, double InBudgetSeconds, int32 InBatchSize = 16);
+
+	// Stops the draining, the results left stay in the queue
+	void Unregister();
+
+	FORCEINLINE bool IsRegistered() const { return TickFunction.IsTickFunctionRegistered(); }
+	FORCEINLINE void SetBudget(double InBudgetSeconds) { BudgetSeconds = InBudgetSeconds; }
+
+	// Handles the waiting results within the budget. Game thread only. Returns the number of results handled
+	int32 Drain();
+
+	// Handles all the waiting results, ignoring the budget. Game thread only
+	int32 DrainAll();
+
+	// Returns the number of results rejected because the queue was full
+	FORCEINLINE uint64 GetNumDropped() const { return NumDropped.load(std::memory_order_relaxed); }
+
+protected:
+	// Handles up to MaxCount results, returns how many were handled
+	virtual int32 DrainBatch(int32 MaxCount) = 0;
+
+	std::atomic<uint64> NumDropped{0};
+
+private:
+	FGameThreadResultSinkTickFunction TickFunction;
+	double BudgetSeconds = 0.0;
+
+	// Results handled between two checks of the budget
+	int32 BatchSize = 16;
+};
+
+/**
+ * Result sink of a type of results, handled one by one by a function on the game thread.
+ */
+template<typename T>
+class TGameThreadResultSink final : public FGameThreadResultSinkBase
+{
+public:
+	using FHandler = TUniqueFunction<void(T&&)>;
+
+	/**
+	 * @param Capacity Maximum number of results waiting, rounded up to a power of two.
+	 * @param InHandler Called on the game thread with every result.
+	 */
+	TGameThreadResultSink(uint32 Capacity, FHandler&& InHandler)
+		: Queue(Capacity)
+		, Handler(MoveTemp(InHandler))
+	{
+	}
+
+	/**
+	 * Queues a result for the game thread. Can be called from any thread.
+	 *
+	 * @param Args Arguments of the constructor of the result.
+	 * @return False if the queue is full, the result is dropped then.
+	 */
+	template<typename... ArgTypes>
+	bool Push(ArgTypes&&... Args)
+	{
+		if (Queue.TryPush(Forward<ArgTypes>(Args)...))
+		{
+			return true;
+		}
+		NumDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	FORCEINLINE int32 GetNumPending() const { return Queue.Num(); }
+
+protected:
+	virtual int32 DrainBatch(int32 MaxCount) override
+	{
+		return Queue.Drain([this](T&& Result) { Handler(MoveTemp(Result)); }, MaxCount);
+	}
+
+private:
+	TMpscRingQueue<T> Queue;
+	FHandler Handler;
+};
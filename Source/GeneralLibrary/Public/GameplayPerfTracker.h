@@ -0,0 +1,72 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Accumulates the game thread time spent in named gameplay scopes (traces, detection, items...).
+ * It does nothing until it is enabled, so the scopes can stay in shipping code paths.
+ * Used by the benchmarks to report the time spent per subsystem.
+ */
+class GENERALLIBRARY_API FGameplayPerfTracker
+{
+public:
+	struct FScopeStats
+	{
+		uint64 Cycles = 0;
+		uint64 Calls = 0;
+	};
+
+	static FGameplayPerfTracker& Get();
+
+	// Enables or disables the tracking, enabling it resets the accumulated times
+	void SetEnabled(bool bInEnabled);
+
+	// Read by every FGameplayPerfScope, worker threads included
+	FORCEINLINE bool IsEnabled() const { return bEnabled.load(std::memory_order_relaxed); }
+
+	// Adds the time spent in a scope
+	void AddScopeTime(FName ScopeName, uint64 Cycles);
+
+	// Clears the accumulated times
+	void Reset();
+
+	FORCEINLINE const TMap<FName, FScopeStats>& GetScopeStats() const { return ScopeStats; }
+
+private:
+	TMap<FName, FScopeStats> ScopeStats;
+	std::atomic<bool> bEnabled{false};
+};
+
+/**
+ * Measures the time between its construction and destruction and adds it to the FGameplayPerfTracker.
+ * Only the game thread is tracked.
+ */
+class FGameplayPerfScope
+{
+public:
+	explicit FGameplayPerfScope(const FName InScopeName)
+		: ScopeName(InScopeName)
+		, StartCycles(FGameplayPerfTracker::Get().IsEnabled() && IsInGameThread() ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FGameplayPerfScope()
+	{
+		if (StartCycles != 0)
+		{
+			FGameplayPerfTracker::Get().AddScopeTime(ScopeName, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+	FName ScopeName;
+	uint64 StartCycles;
+};
+
+// Tracks the time spent in the current scope under the given name
+#define GENLIB_PERF_SCOPE(Name) \
+	static const FName PREPROCESSOR_JOIN(GameplayPerfScopeName_, __LINE__)(TEXT(Name)); \
+	FGameplayPerfScope PREPROCESSOR_JOIN(GameplayPerfScope_, __LINE__)(PREPROCESSOR_JOIN(GameplayPerfScopeName_, __LINE__))
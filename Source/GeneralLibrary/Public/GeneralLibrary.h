@@ -14,4 +14,7 @@ class FGeneralLibraryModule : public IModuleInterface
 public:
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+    FDelegateHandle EndFrameHandle;
 };
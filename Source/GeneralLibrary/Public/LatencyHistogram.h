@@ -0,0 +1,46 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Histogram of latencies in milliseconds with fixed buckets growing geometrically from 0.1 ms to about 20 s,
+ * so adding a sample is constant time without allocations and the precision is relative to the value.
+ * The percentiles are interpolated inside their bucket.
+ */
+class GENERALLIBRARY_API FLatencyHistogram
+{
+public:
+	static constexpr int32 NumBuckets = 48;
+
+	// Upper bound of the first bucket and growth of the bounds from one bucket to the next
+	static constexpr double FirstBucketMs = 0.1;
+	static constexpr double BucketGrowth = 1.3;
+
+	// Adds a latency, the ones over the last bucket are counted in it
+	void Add(double LatencyMs);
+
+	void Reset();
+
+	/**
+	 * Returns the latency under which a percentage of the samples are.
+	 *
+	 * @param Percent Percentage of the samples, between 0 and 1.
+	 * @return The latency in milliseconds, 0 without samples.
+	 */
+	double GetPercentile(double Percent) const;
+
+	FORCEINLINE uint64 Num() const { return Count; }
+	FORCEINLINE double GetAverage() const { return Count > 0 ? SumMs / Count : 0.0; }
+	FORCEINLINE double GetMax() const { return MaxMs; }
+
+	// Returns the upper bound in milliseconds of a bucket
+	static double GetBucketUpperBound(int32 Bucket);
+
+private:
+	TStaticArray<uint32, NumBuckets> Buckets = TStaticArray<uint32, NumBuckets>(InPlace, 0);
+	uint64 Count = 0;
+	double SumMs = 0.0;
+	double MaxMs = 0.0;
+};
@@ -0,0 +1,201 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Stats/Stats.h"
+#include <type_traits>
+
+/**
+ * Cell data of the levels of a world linked to a spatial registry, next to its elements registered one by one.
+ * The cell data is built with the level (see FSpatialCellIndex) and stored in it as asset user data, so a level
+ * is linked in constant time when its first element begins play: only the flags of the elements leaving the cell
+ * data are allocated. The levels are unlinked when they are removed from the world.
+ * CellDataType is a UAssetUserData with an FSpatialCellIndex Index, and its elements in Components in the same order.
+ */
+template<typename CellDataType>
+class TLinkedCellRegistry
+{
+public:
+	TLinkedCellRegistry() = default;
+	~TLinkedCellRegistry() { Reset(); }
+
+	UE_NONCOPYABLE(TLinkedCellRegistry);
+
+	/**
+	 * Starts unlinking the levels removed from a world.
+	 *
+	 * @param InWorld The world of the registry.
+	 * @param InStatName Accumulator stat counting the linked levels, see GET_STATFNAME. None counts nothing.
+	 */
+	void Initialize(const UWorld* InWorld, FName InStatName = NAME_None)
+	{
+		Reset();
+		World = InWorld;
+		StatName = InStatName;
+		LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &TLinkedCellRegistry::HandleLevelRemovedFromWorld);
+	}
+
+	// Unlinks every level and stops listening to the world
+	void Reset()
+	{
+		FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+		LevelRemovedHandle.Reset();
+		DEC_DWORD_STAT_FNAME_BY(StatName, LinkedCells.Num());
+		LinkedCells.Reset();
+	}
+
+	/**
+	 * Links the cell data of the level of an element, if it is not linked yet.
+	 *
+	 * @param Level The level of the element.
+	 * @param Component The element beginning play.
+	 * @param EntryIndex Index of the element in the cell data of the level.
+	 * @param Location Current location of the element, as saved in the cell data.
+	 * @return True if the element is in the linked cell data and doesn't need to be registered alone.
+	 */
+	template<typename ComponentType>
+	bool Link(ULevel* Level, const ComponentType* Component, int32 EntryIndex, const FVector& Location)
+	{
+		if (!Level)
+		{
+			return false;
+		}
+
+		FLinkedCell* LinkedCell = LinkedCells.Find(Level);
+		if (!LinkedCell)
+		{
+			const CellDataType* CellData = Level->GetAssetUserData<CellDataType>();
+			if (!CellData)
+			{
+				return false;
+			}
+
+			LinkedCell = &LinkedCells.Add(Level);
+			LinkedCell->Data = CellData;
+			LinkedCell->Detached.Init(false, CellData->Components.Num());
+			INC_DWORD_STAT_FNAME_BY(StatName, 1);
+		}
+
+		// The cell data may be older than the element, or the element may have moved since it was saved
+		// (e.g. pooled and placed elsewhere), in both cases it is registered alone
+		const CellDataType* CellData = LinkedCell->Data.Get();
+		if (!CellData || !CellData->Components.IsValidIndex(EntryIndex) || CellData->Components[EntryIndex] != Component
+			|| !CellData->Index.GetLocation(EntryIndex).Equals(Location))
+		{
+			return false;
+		}
+
+		// Attached again if it left and came back
+		LinkedCell->Detached[EntryIndex] = false;
+		return true;
+	}
+
+	// Removes an element from the linked cell data of its level, e.g. when it is destroyed or moved
+	void Detach(const ULevel* Level, int32 EntryIndex)
+	{
+		FLinkedCell* LinkedCell = LinkedCells.Find(Level);
+		if (LinkedCell && LinkedCell->Detached.IsValidIndex(EntryIndex))
+		{
+			LinkedCell->Detached[EntryIndex] = true;
+		}
+	}
+
+	// Returns the number of linked levels
+	FORCEINLINE int32 Num() const { return LinkedCells.Num(); }
+
+	FORCEINLINE bool IsEmpty() const { return LinkedCells.IsEmpty(); }
+
+	/**
+	 * Calls a function for the elements of the linked levels inside a sphere, skipping the detached ones.
+	 *
+	 * @param Center Center of the query sphere.
+	 * @param Radius Radius of the query sphere, or a function returning it for a cell data, e.g. to add its biggest element.
+	 * @param Func Function called as Func(const CellDataType& CellData, int32 Index, const FVector& Location, float DistSquared).
+	 */
+	template<typename RadiusType, typename FuncType>
+	void ForEachInRadius(const FVector& Center, RadiusType&& Radius, FuncType&& Func) const
+	{
+		for (const TPair<TObjectKey<ULevel>, FLinkedCell>& Pair : LinkedCells)
+		{
+			const FLinkedCell& LinkedCell = Pair.Value;
+			const CellDataType* CellData = LinkedCell.Data.Get();
+			if (!CellData)
+			{
+				continue;
+			}
+
+			float CellRadius;
+			if constexpr (std::is_invocable_v<RadiusType, const CellDataType&>)
+			{
+				CellRadius = Radius(*CellData);
+			}
+			else
+			{
+				CellRadius = Radius;
+			}
+
+			CellData->Index.ForEachInRadius(Center, CellRadius, [&](int32 Index, const FVector& Location, float DistSquared)
+			{
+				if (!LinkedCell.Detached[Index] && IsValid(CellData->Components[Index]))
+				{
+					Func(*CellData, Index, Location, DistSquared);
+				}
+			});
+		}
+	}
+
+private:
+	struct FLinkedCell
+	{
+		TWeakObjectPtr<const CellDataType> Data;
+
+		// Elements of the cell data that are no longer there
+		TBitArray<> Detached;
+	};
+
+	void HandleLevelRemovedFromWorld(ULevel* Level, UWorld* InWorld)
+	{
+		if (InWorld == World.Get() && LinkedCells.Remove(Level) > 0)
+		{
+			DEC_DWORD_STAT_FNAME_BY(StatName, 1);
+		}
+	}
+
+	TMap<TObjectKey<ULevel>, FLinkedCell> LinkedCells;
+
+	TWeakObjectPtr<const UWorld> World;
+
+	FName StatName;
+
+	FDelegateHandle LevelRemovedHandle;
+};
+
+#if WITH_EDITOR
+/**
+ * Builds a type of cell data when a level is cooked, World Partition cells included.
+ * Non partitioned maps also build it on every save, so PIE uses the same path as the cooked game.
+ * Declared as a static object next to the cell data type:
+ * static FCellDataBuilder GMyCellDataBuilder(&UMyCellData::BuildForLevel);
+ */
+class GENERALLIBRARY_API FCellDataBuilder
+{
+public:
+	using FBuildFunction = void (*)(ULevel*);
+
+	explicit FCellDataBuilder(FBuildFunction InBuildFunction);
+	~FCellDataBuilder();
+
+	UE_NONCOPYABLE(FCellDataBuilder);
+
+	// Builds every type of cell data of a level
+	static void BuildAll(ULevel* Level);
+
+private:
+	static TArray<FCellDataBuilder*>& GetBuilders();
+
+	FBuildFunction BuildFunction;
+};
+#endif
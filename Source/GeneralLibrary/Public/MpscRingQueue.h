@@ -0,0 +1,159 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Bounded lock-free queue with many producers and a single consumer.
+ * Every slot of the ring has a sequence number telling if it is free for the producer of a position or
+ * filled for the consumer, so the producers only contend on the tail counter and never wait for each
+ * other to finish writing. The tail, the head and the slots are on different cache lines.
+ * Pushing fails instead of blocking when the queue is full. Only one thread at a time may pop or drain.
+ */
+template<typename T>
+class TMpscRingQueue
+{
+public:
+	/**
+	 * @param InCapacity Maximum number of elements in the queue, rounded up to a power of two.
+	 */
+	explicit TMpscRingQueue(uint32 InCapacity)
+	{
+		const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+		Mask = Capacity - 1;
+		Slots = new FSlot[Capacity];
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+	}
+
+	~TMpscRingQueue()
+	{
+		Drain([](T&&) {});
+		delete[] Slots;
+	}
+
+	TMpscRingQueue(const TMpscRingQueue&) = delete;
+	TMpscRingQueue& operator=(const TMpscRingQueue&) = delete;
+
+	/**
+	 * Constructs an element at the end of the queue. Can be called from any thread.
+	 *
+	 * @param Args Arguments of the constructor of the element.
+	 * @return False if the queue is full, nothing is constructed then.
+	 */
+	template<typename... ArgTypes>
+	bool TryPush(ArgTypes&&... Args)
+	{
+		uint64 Position = Tail.Value.load(std::memory_order_relaxed);
+		FSlot* Slot;
+		for (;;)
+		{
+			Slot = &Slots[Position & Mask];
+			const uint64 Sequence = Slot->Sequence.load(std::memory_order_acquire);
+			const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+			if (Difference == 0)
+			{
+				// The slot is free, claim the position
+				if (Tail.Value.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (Difference < 0)
+			{
+				// The slot still holds the element of the previous lap, the consumer is behind
+				return false;
+			}
+			else
+			{
+				Position = Tail.Value.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (Slot->Storage.GetTypedPtr()) T(Forward<ArgTypes>(Args)...);
+		Slot->Sequence.store(Position + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * Removes the first element of the queue. Consumer thread only.
+	 *
+	 * @param OutElement Receives the element.
+	 * @return False if the queue is empty, or its first element is still being written.
+	 */
+	bool TryPop(T& OutElement)
+	{
+		return Drain([&OutElement](T&& Element) { OutElement = MoveTemp(Element); }, 1) == 1;
+	}
+
+	/**
+	 * Removes the elements at the start of the queue and passes them to a function. Consumer thread only.
+	 * Stops at the first element a producer is still writing, the next drain gets it.
+	 *
+	 * @param Func Called with every element, as void(T&&).
+	 * @param MaxCount Maximum number of elements removed.
+	 * @return The number of elements removed.
+	 */
+	template<typename FuncType>
+	int32 Drain(FuncType&& Func, int32 MaxCount = MAX_int32)
+	{
+		int32 Count = 0;
+		while (Count < MaxCount)
+		{
+			FSlot& Slot = Slots[Head.Value & Mask];
+			if (Slot.Sequence.load(std::memory_order_acquire) != Head.Value + 1)
+			{
+				break;
+			}
+
+			T* Element = Slot.Storage.GetTypedPtr();
+			Func(MoveTemp(*Element));
+			DestructItem(Element);
+
+			// Frees the slot for the producer of the same position on the next lap
+			Slot.Sequence.store(Head.Value + Mask + 1, std::memory_order_release);
+			++Head.Value;
+			++Count;
+		}
+		return Count;
+	}
+
+	// Returns the number of elements in the queue. Only exact when the producers are idle
+	int32 Num() const
+	{
+		return static_cast<int32>(Tail.Value.load(std::memory_order_relaxed) - Head.Value);
+	}
+
+	FORCEINLINE bool IsEmpty() const { return Num() == 0; }
+	FORCEINLINE int32 GetCapacity() const { return static_cast<int32>(Mask + 1); }
+
+private:
+	struct FSlot
+	{
+		std::atomic<uint64> Sequence;
+		TTypeCompatibleBytes<T> Storage;
+	};
+
+	// Written by the producers
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FTail
+	{
+		std::atomic<uint64> Value{0};
+	};
+
+	// Only touched by the consumer
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FHead
+	{
+		uint64 Value = 0;
+	};
+
+	// Read-only after the construction, shared by every thread
+	FSlot* Slots = nullptr;
+	uint64 Mask = 0;
+
+	FTail Tail;
+	FHead Head;
+};
@@ -0,0 +1,94 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformProcess.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Sequence lock publishing a value from a single writer thread to any number of reader threads without locks.
+ * The writer never waits. A reader copies the value and retries if the writer changed it during the copy,
+ * so reads are cheap while writes are rare compared to them (e.g. once per frame).
+ * The value is stored as relaxed atomic words, so the racing copies are well defined.
+ * ValueType must be trivially copyable: weak object pointers can be published, but only resolved on the game thread.
+ */
+template<typename ValueType>
+class TSeqLock
+{
+	static_assert(std::is_trivially_copyable_v<ValueType>, "TSeqLock values are copied while they are written, they must be trivially copyable.");
+
+public:
+	TSeqLock()
+	{
+		Write(ValueType());
+	}
+
+	explicit TSeqLock(const ValueType& InitialValue)
+	{
+		Write(InitialValue);
+	}
+
+	TSeqLock(const TSeqLock&) = delete;
+	TSeqLock& operator=(const TSeqLock&) = delete;
+
+	/**
+	 * Publishes a new value. Only one thread may write.
+	 *
+	 * @param Value The new value.
+	 */
+	void Write(const ValueType& Value)
+	{
+		uint64 Buffer[NumWords] = {};
+		FMemory::Memcpy(Buffer, &Value, sizeof(ValueType));
+
+		// Odd while writing, the readers copying at the same time retry
+		const uint32 Begin = Sequence.load(std::memory_order_relaxed);
+		Sequence.store(Begin + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		for (int32 Index = 0; Index < NumWords; ++Index)
+		{
+			Words[Index].store(Buffer[Index], std::memory_order_relaxed);
+		}
+
+		Sequence.store(Begin + 2, std::memory_order_release);
+	}
+
+	// Returns a copy of the last published value, from any thread
+	ValueType Read() const
+	{
+		uint64 Buffer[NumWords];
+		uint32 Begin;
+		do
+		{
+			Begin = Sequence.load(std::memory_order_acquire);
+			while (Begin & 1)
+			{
+				FPlatformProcess::YieldThread();
+				Begin = Sequence.load(std::memory_order_acquire);
+			}
+
+			for (int32 Index = 0; Index < NumWords; ++Index)
+			{
+				Buffer[Index] = Words[Index].load(std::memory_order_relaxed);
+			}
+			std::atomic_thread_fence(std::memory_order_acquire);
+		}
+		while (Sequence.load(std::memory_order_relaxed) != Begin);
+
+		ValueType Value;
+		FMemory::Memcpy(&Value, Buffer, sizeof(ValueType));
+		return Value;
+	}
+
+	// Number of values published, readers can compare it to skip the copy if nothing changed
+	FORCEINLINE uint32 GetVersion() const { return Sequence.load(std::memory_order_acquire) >> 1; }
+
+private:
+	static constexpr int32 NumWords = (sizeof(ValueType) + sizeof(uint64) - 1) / sizeof(uint64);
+
+	std::atomic<uint32> Sequence = 0;
+	std::atomic<uint64> Words[NumWords];
+};
@@ -0,0 +1,100 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpatialCellIndex.generated.h"
+
+/**
+ * Immutable 2D grid of locations, built once (e.g. when a level is cooked) and serialized with its owner.
+ * The locations are sorted by cell, so every cell is a contiguous range and nothing has to be inserted
+ * when the owner is loaded. The owner keeps its own per-element data in the same order as the locations.
+ */
+USTRUCT()
+struct GENERALLIBRARY_API FSpatialCellIndex
+{
+	GENERATED_BODY()
+
+	/**
+	 * Builds the index from unsorted locations.
+	 *
+	 * @param InLocations Locations of the elements.
+	 * @param InCellSize Size of the side of a cell in world units.
+	 * @param OutOrder For every sorted element, its index in InLocations. Used to sort the data of the owner.
+	 */
+	void Build(TConstArrayView<FVector> InLocations, float InCellSize, TArray<int32>& OutOrder);
+
+	void Reset();
+
+	FORCEINLINE int32 Num() const { return Locations.Num(); }
+
+	FORCEINLINE const FVector& GetLocation(int32 Index) const { return Locations[Index]; }
+
+	// Checks if the bounds of the elements overlap a sphere, to skip the whole index cheaply
+	FORCEINLINE bool Intersects(const FVector& Center, float Radius) const
+	{
+		return Bounds.IsValid && Bounds.ComputeSquaredDistanceToPoint(Center) <= FMath::Square(Radius);
+	}
+
+	/**
+	 * Calls a function for every element inside a sphere.
+	 *
+	 * @param Center Center of the query sphere.
+	 * @param Radius Radius of the query sphere.
+	 * @param Func Function called as Func(int32 Index, const FVector& Location, float DistSquared).
+	 */
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& Center, const float Radius, FuncType&& Func) const
+	{
+		if (!Intersects(Center, Radius))
+		{
+			return;
+		}
+
+		const float RadiusSquared = Radius * Radius;
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				const FIntPoint* Range = CellRanges.Find(FIntPoint(X, Y));
+				if (!Range)
+				{
+					continue;
+				}
+
+				for (int32 Index = Range->X; Index < Range->X + Range->Y; ++Index)
+				{
+					const float DistSquared = FVector::DistSquared(Center, Locations[Index]);
+					if (DistSquared <= RadiusSquared)
+					{
+						Func(Index, Locations[Index], DistSquared);
+					}
+				}
+			}
+		}
+	}
+
+private:
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		const float InvCellSize = 1.0f / CellSize;
+		return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+	}
+
+	UPROPERTY()
+	float CellSize = 1000.0f;
+
+	UPROPERTY()
+	FBox Bounds = FBox(ForceInit);
+
+	// Locations of the elements, sorted by cell
+	UPROPERTY()
+	TArray<FVector> Locations;
+
+	// Range of every non empty cell in Locations: X is the first element and Y the number of elements
+	UPROPERTY()
+	TMap<FIntPoint, FIntPoint> CellRanges;
+};
@@ -0,0 +1,166 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Uniform 2D hash grid storing elements by world location.
+ * The world is split in square cells on the XY plane, and radius queries only visit the cells
+ * overlapping the query circle, testing the elements with a squared distance check.
+ * ElementType must be comparable with operator== to be removed.
+ */
+template<typename ElementType>
+class TSpatialHashGrid
+{
+public:
+	explicit TSpatialHashGrid(const float InCellSize = 1000.0f)
+	{
+		SetCellSize(InCellSize);
+	}
+
+	/**
+	 * Changes the size of the cells. The grid is rebuilt with the elements already stored.
+	 *
+	 * @param InCellSize Size of the side of a cell in world units.
+	 */
+	void SetCellSize(const float InCellSize)
+	{
+		CellSize = FMath::Max(InCellSize, 1.0f);
+		InvCellSize = 1.0f / CellSize;
+
+		if (NumElements > 0)
+		{
+			TMap<FIntPoint, TArray<FEntry>> OldCells = MoveTemp(Cells);
+			Cells.Reset();
+			NumElements = 0;
+			for (const TPair<FIntPoint, TArray<FEntry>>& Cell : OldCells)
+			{
+				for (const FEntry& Entry : Cell.Value)
+				{
+					Add(Entry.Element, Entry.Location);
+				}
+			}
+		}
+	}
+
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+	// Adds an element at a location
+	void Add(const ElementType& Element, const FVector& Location)
+	{
+		Cells.FindOrAdd(GetCell(Location)).Add({ Element, Location });
+		++NumElements;
+	}
+
+	/**
+	 * Removes an element added at a location.
+	 *
+	 * @return True if the element was found and removed.
+	 */
+	bool Remove(const ElementType& Element, const FVector& Location)
+	{
+		const FIntPoint Cell = GetCell(Location);
+		TArray<FEntry>* Entries = Cells.Find(Cell);
+		if (!Entries)
+		{
+			return false;
+		}
+
+		const int32 Index = Entries->IndexOfByPredicate([&Element](const FEntry& Entry) { return Entry.Element == Element; });
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+
+		Entries->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		if (Entries->IsEmpty())
+		{
+			Cells.Remove(Cell);
+		}
+		--NumElements;
+		return true;
+	}
+
+	// Moves an element from its old location to a new one
+	void Move(const ElementType& Element, const FVector& OldLocation, const FVector& NewLocation)
+	{
+		if (GetCell(OldLocation) == GetCell(NewLocation))
+		{
+			if (TArray<FEntry>* Entries = Cells.Find(GetCell(OldLocation)))
+			{
+				if (FEntry* Entry = Entries->FindByPredicate([&Element](const FEntry& It) { return It.Element == Element; }))
+				{
+					Entry->Location = NewLocation;
+				}
+			}
+			return;
+		}
+
+		if (Remove(Element, OldLocation))
+		{
+			Add(Element, NewLocation);
+		}
+	}
+
+	/**
+	 * Calls a function for every element inside a sphere.
+	 *
+	 * @param Center Center of the query sphere.
+	 * @param Radius Radius of the query sphere.
+	 * @param Func Function called as Func(const ElementType& Element, const FVector& Location, float DistSquared).
+	 */
+	template<typename FuncType>
+	void ForEachInRadius(const FVector& Center, const float Radius, FuncType&& Func) const
+	{
+		const float RadiusSquared = Radius * Radius;
+		const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+		const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				const TArray<FEntry>* Entries = Cells.Find(FIntPoint(X, Y));
+				if (!Entries)
+				{
+					continue;
+				}
+
+				for (const FEntry& Entry : *Entries)
+				{
+					const float DistSquared = FVector::DistSquared(Center, Entry.Location);
+					if (DistSquared <= RadiusSquared)
+					{
+						Func(Entry.Element, Entry.Location, DistSquared);
+					}
+				}
+			}
+		}
+	}
+
+	FORCEINLINE int32 Num() const { return NumElements; }
+
+	void Reset()
+	{
+		Cells.Reset();
+		NumElements = 0;
+	}
+
+private:
+	struct FEntry
+	{
+		ElementType Element;
+		FVector Location;
+	};
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+	}
+
+	TMap<FIntPoint, TArray<FEntry>> Cells;
+	float CellSize = 1000.0f;
+	float InvCellSize = 0.001f;
+	int32 NumElements = 0;
+};
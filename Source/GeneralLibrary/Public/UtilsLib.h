@@ -32,8 +32,36 @@ public:
 		float Size,
 		EDrawDebugTrace::Type DrawDebugType,
 		ECollisionChannel TraceChannel,
+		TArray<FHitResult>& OutHitResults,
+		float CapsuleHalfHeight = 0.0f
+	);
+
+	/**
+	 * Sweeps a capsule wrapping a moving segment, like the blade of a weapon between two animation samples.
+	 * The capsule is oriented along the mean axis of both samples,
+	 * so the samples should be close enough for the segment to rotate little between them.
+	 *
+	 * @param World World where the sweep is performed.
+	 * @param StartBase Base of the segment at the start of the sweep.
+	 * @param StartTip Tip of the segment at the start of the sweep.
+	 * @param EndBase Base of the segment at the end of the sweep.
+	 * @param EndTip Tip of the segment at the end of the sweep.
+	 * @param Radius Radius of the capsule around the segment.
+	 * @param TraceChannel Collision channel of the sweep.
+	 * @param QueryParams Parameters of the query, with the ignored actors.
+	 * @param OutHitResults Hits of the sweep.
+	 * @return True if anything was hit.
+	 */
+	static bool SweepCapsuleBetweenSegments(
+		const UWorld* World,
+		const FVector& StartBase,
+		const FVector& StartTip,
+		const FVector& EndBase,
+		const FVector& EndTip,
+		float Radius,
+		ECollisionChannel TraceChannel,
+		const FCollisionQueryParams& QueryParams,
 		TArray<FHitResult>& OutHitResults
 	);
-	
-	
+
 };
@@ -0,0 +1,82 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Cone of view of a viewer, e.g. the camera of a player or the eyes of an AI.
+ */
+struct FViewCone
+{
+	FVector3f Origin = FVector3f::ZeroVector;
+
+	// Direction of the cone, normalized
+	FVector3f Forward = FVector3f::ForwardVector;
+
+	// Cosine of the angle between the direction and the side of the cone
+	float CosHalfAngle = 0.5f;
+
+	float MaxRange = 1000.0f;
+
+	FViewCone() = default;
+
+	FViewCone(const FVector& InOrigin, const FVector& InForward, float HalfAngleDegrees, float InMaxRange)
+		: Origin(InOrigin)
+		, Forward(FVector3f(InForward).GetSafeNormal())
+		, CosHalfAngle(FMath::Cos(FMath::DegreesToRadians(HalfAngleDegrees)))
+		, MaxRange(InMaxRange)
+	{
+	}
+};
+
+/**
+ * Positions stored as structure of arrays, so they are tested four at a time by FViewConeFilter.
+ * The radii are optional: empty, or one per position.
+ */
+struct GENERALLIBRARY_API FViewConeCandidates
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<float> Radii;
+
+	void Reset();
+	void Reserve(int32 Num);
+
+	// Adds a position, the radius is only stored if the candidates have radii
+	void Add(const FVector& Location, float Radius = 0.0f);
+
+	FORCEINLINE int32 Num() const { return X.Num(); }
+	FORCEINLINE FVector GetLocation(int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+};
+
+/**
+ * Tests many positions against a view cone and a distance with SIMD, before any physics query is done.
+ * A position with a radius passes if the sphere can touch the cone: the range is extended by the radius
+ * and the angle is conservatively widened by it.
+ */
+struct GENERALLIBRARY_API FViewConeFilter
+{
+	/**
+	 * Appends the indices of the positions inside the cone.
+	 *
+	 * @param Cone The view cone.
+	 * @param X, Y, Z Coordinates of the positions, of the same size.
+	 * @param Radii Radius of every position, or empty to test points.
+	 * @param OutIndices Indices of the positions inside the cone, in increasing order.
+	 * @return Number of indices added.
+	 */
+	static int32 Filter(const FViewCone& Cone, TConstArrayView<float> X, TConstArrayView<float> Y, TConstArrayView<float> Z,
+		TConstArrayView<float> Radii, TArray<int32>& OutIndices);
+
+	static int32 Filter(const FViewCone& Cone, const FViewConeCandidates& Candidates, TArray<int32>& OutIndices)
+	{
+		return Filter(Cone, Candidates.X, Candidates.Y, Candidates.Z, Candidates.Radii, OutIndices);
+	}
+
+	/**
+	 * Returns how centered a position is in the cone, from -1 behind to 1 on its axis. Used to rank the candidates.
+	 */
+	static float GetAlignment(const FViewCone& Cone, const FVector& Location);
+};
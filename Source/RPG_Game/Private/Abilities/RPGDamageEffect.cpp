@@ -0,0 +1,19 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Abilities/RPGDamageEffect.h"
+#include "Abilities/RPGAttributeSet.h"
+#include "Core/RPGGameplayTags.h"
+
+URPGDamageEffect::URPGDamageEffect()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FSetByCallerFloat DamageMagnitude;
+	DamageMagnitude.DataTag = RPGGameplayTags::SetByCaller_Damage;
+
+	FGameplayModifierInfo DamageModifier;
+	DamageModifier.Attribute = URPGAttributeSet::GetDamageAttribute();
+	DamageModifier.ModifierOp = EGameplayModOp::Additive;
+	DamageModifier.ModifierMagnitude = FGameplayEffectModifierMagnitude(DamageMagnitude);
+	Modifiers.Add(DamageModifier);
+}
@@ -0,0 +1,80 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Benchmark/RPGBenchmarkActors.h"
+#include "Camera/CameraComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "AbilitySystemComponent.h"
+#include "Abilities/RPGAttributeSet.h"
+#include "Inventory/EquipmentComponent.h"
+#include "Components/FPP_InteractorComponent.h"
+#include "Components/FPP_InteractableComponent.h"
+
+ARPGBenchmarkPawn::ARPGBenchmarkPawn()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("CameraComponent"));
+	RootComponent = CameraComponent;
+
+	InteractorComponent = CreateDefaultSubobject<UFPP_InteractorComponent>(TEXT("InteractorComponent"));
+	InteractorComponent->DetectionDistance = 500.0f;
+}
+
+void ARPGBenchmarkPawn::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// The pawn is not player controlled, so the detection has to be started manually
+	InteractorComponent->Activate();
+}
+
+void ARPGBenchmarkPawn::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AddActorWorldRotation(FRotator(0.0f, TurnRate * DeltaTime, 0.0f));
+}
+
+ARPGBenchmarkInteractable::ARPGBenchmarkInteractable()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BoxComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("BoxComponent"));
+	BoxComponent->InitBoxExtent(FVector(25.0f));
+	BoxComponent->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+	RootComponent = BoxComponent;
+
+	InteractableComponent = CreateDefaultSubobject<UFPP_InteractableComponent>(TEXT("InteractableComponent"));
+}
+
+ARPGBenchmarkCombatant::ARPGBenchmarkCombatant()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	CapsuleComponent = CreateDefaultSubobject<UCapsuleComponent>(TEXT("CapsuleComponent"));
+	CapsuleComponent->InitCapsuleSize(34.0f, 88.0f);
+	CapsuleComponent->SetCollisionProfileName(UCollisionProfile::Pawn_ProfileName);
+	RootComponent = CapsuleComponent;
+
+	AbilitySystemComponent = CreateDefaultSubobject<UAbilitySystemComponent>(TEXT("AbilitySystemComponent"));
+	AttributeSet = CreateDefaultSubobject<URPGAttributeSet>(TEXT("AttributeSet"));
+}
+
+void ARPGBenchmarkCombatant::BeginPlay()
+{
+	Super::BeginPlay();
+
+	AbilitySystemComponent->InitAbilityActorInfo(this, this);
+}
+
+ARPGBenchmarkEquippedCharacter::ARPGBenchmarkEquippedCharacter()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	BodyComponent = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("BodyComponent"));
+	BodyComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RootComponent = BodyComponent;
+
+	EquipmentComponent = CreateDefaultSubobject<UEquipmentComponent>(TEXT("EquipmentComponent"));
+}
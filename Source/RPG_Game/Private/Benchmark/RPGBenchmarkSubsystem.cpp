@@ -0,0 +1,603 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Benchmark/RPGBenchmarkSubsystem.h"
+#include "Benchmark/RPGBenchmarkActors.h"
+#include "Items/BaseItem.h"
+#include "Items/ItemPoolSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "RPG_Game/RPG_GameProjectile.h"
+#include "Combat/ProjectileSignificanceSubsystem.h"
+#include "Combat/DamagePipelineSubsystem.h"
+#include "Inventory/EquipmentComponent.h"
+#include "GameplayPerfTracker.h"
+#include "Engine/World.h"
+#include "Engine/DataTable.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/NetDriver.h"
+#include "RHI.h"
+#include "RenderCore.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace RPGBenchmark
+{
+	// Absolute increase in milliseconds ignored when comparing with the baseline, to filter noise on tiny values
+	static constexpr double NoiseThresholdMs = 0.05;
+
+	static float Percentile(TArray<float> Values, const float Percent)
+	{
+		if (Values.IsEmpty())
+		{
+			return 0.0f;
+		}
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt32(Percent * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	static TSharedRef<FJsonObject> MakeDistribution(const TArray<float>& Values)
+	{
+		double Sum = 0.0;
+		float Max = 0.0f;
+		for (const float Value : Values)
+		{
+			Sum += Value;
+			Max = FMath::Max(Max, Value);
+		}
+
+		TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetNumberField(TEXT("avg"), Values.IsEmpty() ? 0.0 : Sum / Values.Num());
+		Object->SetNumberField(TEXT("p50"), Percentile(Values, 0.5f));
+		Object->SetNumberField(TEXT("p90"), Percentile(Values, 0.9f));
+		Object->SetNumberField(TEXT("p95"), Percentile(Values, 0.95f));
+		Object->SetNumberField(TEXT("p99"), Percentile(Values, 0.99f));
+		Object->SetNumberField(TEXT("max"), Max);
+		return Object;
+	}
+
+	static FString GetBenchmarkDir()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("Benchmarks");
+	}
+
+	static FString GetBaselinePath(const FRPGBenchmarkConfig& Config)
+	{
+		FString BaselinePath;
+		if (!FParse::Value(FCommandLine::Get(), TEXT("BenchBaseline="), BaselinePath))
+		{
+			BaselinePath = GetBenchmarkDir() / FString::Printf(TEXT("Baseline_%s.json"), *Config.Name);
+		}
+		return BaselinePath;
+	}
+
+	static bool SaveJson(const TSharedRef<FJsonObject>& Object, const FString& Path)
+	{
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		return FJsonSerializer::Serialize(Object, Writer) && FFileHelper::SaveStringToFile(Output, *Path);
+	}
+
+	static TSharedPtr<FJsonObject> LoadJson(const FString& Path)
+	{
+		FString Input;
+		if (!FFileHelper::LoadFileToString(Input, *Path))
+		{
+			return nullptr;
+		}
+
+		TSharedPtr<FJsonObject> Object;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+		return FJsonSerializer::Deserialize(Reader, Object) ? Object : nullptr;
+	}
+}
+
+void FRPGBenchmarkConfig::Parse(const TCHAR* Params)
+{
+	FParse::Value(Params, TEXT("BenchName="), Name);
+	FParse::Value(Params, TEXT("BenchInteractors="), NumInteractors);
+	FParse::Value(Params, TEXT("BenchInteractables="), NumInteractables);
+	FParse::Value(Params, TEXT("BenchItems="), NumItems);
+	FParse::Value(Params, TEXT("BenchWeapons="), NumWeapons);
+	FParse::Value(Params, TEXT("BenchRPM="), RoundsPerMinute);
+	FParse::Bool(Params, TEXT("BenchProjectileLOD="), bProjectileSignificance);
+	FParse::Value(Params, TEXT("BenchCombatants="), NumCombatants);
+	FParse::Value(Params, TEXT("BenchHitsPerSecond="), HitsPerSecond);
+	FParse::Value(Params, TEXT("BenchEquipped="), NumEquippedCharacters);
+	FParse::Bool(Params, TEXT("BenchMergeEquipment="), bMergeEquipment);
+	FParse::Value(Params, TEXT("BenchWarmup="), WarmupFrames);
+	FParse::Value(Params, TEXT("BenchFrames="), NumFrames);
+	FParse::Value(Params, TEXT("BenchRadius="), SpawnRadius);
+	FParse::Value(Params, TEXT("BenchTolerance="), RegressionTolerance);
+
+	NumFrames = FMath::Max(NumFrames, 1);
+	WarmupFrames = FMath::Max(WarmupFrames, 0);
+}
+
+TSharedRef<FJsonObject> FRPGBenchmarkConfig::ToJson() const
+{
+	TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+	Object->SetStringField(TEXT("name"), Name);
+	Object->SetNumberField(TEXT("interactors"), NumInteractors);
+	Object->SetNumberField(TEXT("interactables"), NumInteractables);
+	Object->SetNumberField(TEXT("items"), NumItems);
+	Object->SetNumberField(TEXT("weapons"), NumWeapons);
+	Object->SetNumberField(TEXT("rounds_per_minute"), RoundsPerMinute);
+	Object->SetBoolField(TEXT("projectile_lod"), bProjectileSignificance);
+	Object->SetNumberField(TEXT("combatants"), NumCombatants);
+	Object->SetNumberField(TEXT("hits_per_second"), HitsPerSecond);
+	Object->SetNumberField(TEXT("equipped_characters"), NumEquippedCharacters);
+	Object->SetBoolField(TEXT("merge_equipment"), bMergeEquipment);
+	Object->SetNumberField(TEXT("warmup_frames"), WarmupFrames);
+	Object->SetNumberField(TEXT("frames"), NumFrames);
+	Object->SetNumberField(TEXT("spawn_radius"), SpawnRadius);
+	return Object;
+}
+
+bool URPGBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void URPGBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Start automatically when the game is launched to run the benchmark
+	if (FParse::Param(FCommandLine::Get(), TEXT("RPGBenchmark")))
+	{
+		FRPGBenchmarkConfig CommandLineConfig;
+		CommandLineConfig.Parse(FCommandLine::Get());
+		StartBenchmark(CommandLineConfig, true);
+	}
+}
+
+void URPGBenchmarkSubsystem::Deinitialize()
+{
+	if (IsRunning())
+	{
+		FGameplayPerfTracker::Get().SetEnabled(false);
+		RestoreConsoleVariables();
+		State = EBenchmarkState::Idle;
+	}
+
+	Super::Deinitialize();
+}
+
+void URPGBenchmarkSubsystem::RestoreConsoleVariables() const
+{
+	if (IConsoleVariable* SignificanceVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("RPG.Projectile.Significance")))
+	{
+		SignificanceVariable->Set(bSavedProjectileSignificance, ECVF_SetByCode);
+	}
+}
+
+TStatId URPGBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(URPGBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+bool URPGBenchmarkSubsystem::StartBenchmark(const FRPGBenchmarkConfig& InConfig, bool bInExitWhenDone)
+{
+	if (IsRunning())
+	{
+		UE_LOG(RPGLog, Warning, TEXT("Benchmark %s is already running."), *Config.Name);
+		return false;
+	}
+
+	Config = InConfig;
+	bExitWhenDone = bInExitWhenDone;
+	bLastRunRegressed = false;
+	ReportPath.Reset();
+
+	// The scenarios missing their assets are skipped, once for the whole run
+	const FString MissingSetup = GetMissingSetup(Config);
+	if (!MissingSetup.IsEmpty())
+	{
+		UE_LOG(RPGLog, Display, TEXT("Benchmark %s skips %s"), *Config.Name, *MissingSetup);
+	}
+	FrameIndex = 0;
+	FrameTimesMs.Reset(Config.NumFrames);
+	GameThreadTimesMs.Reset(Config.NumFrames);
+	RenderThreadTimesMs.Reset(Config.NumFrames);
+	DrawCalls.Reset(Config.NumFrames);
+	LiveProjectiles.Reset(Config.NumFrames);
+	for (TArray<float>& Samples : ProjectilesPerSignificance)
+	{
+		Samples.Reset(Config.NumFrames);
+	}
+
+	// Restored when the run ends, so the benchmark doesn't leave the game in its configuration
+	if (IConsoleVariable* SignificanceVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("RPG.Projectile.Significance")))
+	{
+		bSavedProjectileSignificance = SignificanceVariable->GetBool();
+		SignificanceVariable->Set(Config.bProjectileSignificance, ECVF_SetByCode);
+	}
+
+	StartUsedPhysical = FPlatformMemory::GetStats().UsedPhysical;
+	SpawnScenario();
+
+	State = EBenchmarkState::Warmup;
+	LastFrameSeconds = FPlatformTime::Seconds();
+
+	UE_LOG(RPGLog, Display, TEXT("Benchmark %s started: %d interactors, %d interactables, %d items, %d weapons, %d frames."),
+		*Config.Name, Config.NumInteractors, Config.NumInteractables, Config.NumItems, Config.NumWeapons, Config.NumFrames);
+	return true;
+}
+
+FString URPGBenchmarkSubsystem::GetMissingSetup(const FRPGBenchmarkConfig& InConfig) const
+{
+	TArray<FString> Missing;
+	if (InConfig.NumItems > 0 && ItemDataTable.IsNull())
+	{
+		Missing.Add(TEXT("the items: no ItemDataTable configured."));
+	}
+	if (InConfig.NumEquippedCharacters > 0 && (EquipmentDataTable.IsNull() || EquipmentItems.IsEmpty()))
+	{
+		Missing.Add(TEXT("the equipped characters: no EquipmentDataTable or EquipmentItems configured."));
+	}
+	return FString::Join(Missing, TEXT(" "));
+}
+
+void URPGBenchmarkSubsystem::SpawnScenario()
+{
+	UWorld* World = GetWorld();
+	FRandomStream Random(0x5EED);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	auto RandomLocation = [this, &Random](const float Height)
+	{
+		const FVector2D Point = FVector2D(Random.FRandRange(-1.0f, 1.0f), Random.FRandRange(-1.0f, 1.0f)).GetSafeNormal() * Random.FRandRange(0.0f, Config.SpawnRadius);
+		return FVector(Point.X, Point.Y, Height);
+	};
+
+	for (int32 Index = 0; Index < Config.NumInteractors; ++Index)
+	{
+		const FRotator Rotation(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f);
+		SpawnedActors.Add(World->SpawnActor<ARPGBenchmarkPawn>(ARPGBenchmarkPawn::StaticClass(), RandomLocation(100.0f), Rotation, SpawnParams));
+	}
+
+	for (int32 Index = 0; Index < Config.NumInteractables; ++Index)
+	{
+		SpawnedActors.Add(World->SpawnActor<ARPGBenchmarkInteractable>(ARPGBenchmarkInteractable::StaticClass(), RandomLocation(100.0f), FRotator::ZeroRotator, SpawnParams));
+	}
+
+	if (Config.NumItems > 0 && !ItemDataTable.IsNull())
+	{
+		UItemPoolSubsystem* ItemPool = World->GetSubsystem<UItemPoolSubsystem>();
+		UClass* SpawnedItemClass = ItemClass.IsNull() ? ABaseItem::StaticClass() : ItemClass.LoadSynchronous();
+		UDataTable* DataTable = ItemDataTable.LoadSynchronous();
+		for (int32 Index = 0; Index < Config.NumItems; ++Index)
+		{
+			SpawnedActors.Add(ItemPool->AcquireItem(SpawnedItemClass, DataTable, ItemRowName, FTransform(RandomLocation(0.0f))));
+		}
+	}
+
+	Combatants.Reset(Config.NumCombatants);
+	for (int32 Index = 0; Index < Config.NumCombatants; ++Index)
+	{
+		ARPGBenchmarkCombatant* Combatant = World->SpawnActor<ARPGBenchmarkCombatant>(ARPGBenchmarkCombatant::StaticClass(), RandomLocation(100.0f), FRotator::ZeroRotator, SpawnParams);
+		SpawnedActors.Add(Combatant);
+		Combatants.Add(Combatant);
+	}
+	PendingHits = 0.0f;
+	HitsRandom.Initialize(0xDA3A6E);
+
+	if (Config.NumEquippedCharacters > 0 && !EquipmentDataTable.IsNull() && !EquipmentItems.IsEmpty())
+	{
+		UDataTable* DataTable = EquipmentDataTable.LoadSynchronous();
+		USkeletalMesh* BaseMesh = EquipmentBaseMesh.LoadSynchronous();
+		for (int32 Index = 0; Index < Config.NumEquippedCharacters; ++Index)
+		{
+			const FTransform Transform(RandomLocation(0.0f));
+			ARPGBenchmarkEquippedCharacter* Character = World->SpawnActorDeferred<ARPGBenchmarkEquippedCharacter>(ARPGBenchmarkEquippedCharacter::StaticClass(), Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+			UEquipmentComponent* Equipment = Character->GetEquipmentComponent();
+			Equipment->ItemDataTable = DataTable;
+			Equipment->BaseMesh = BaseMesh;
+			Equipment->bMergeArmorMeshes = Config.bMergeEquipment;
+			Character->FinishSpawning(Transform);
+
+			for (const FName ItemId : EquipmentItems)
+			{
+				Equipment->EquipItem(ItemId);
+			}
+			SpawnedActors.Add(Character);
+		}
+	}
+
+	LoadedProjectileClass = ProjectileClass.IsNull() ? ARPG_GameProjectile::StaticClass() : ProjectileClass.LoadSynchronous();
+	Weapons.Reset(Config.NumWeapons);
+	for (int32 Index = 0; Index < Config.NumWeapons; ++Index)
+	{
+		// The weapons are spread on the border of the area and fire towards the center
+		const FVector Location = FRotator(0.0f, 360.0f * Index / Config.NumWeapons, 0.0f).Vector() * Config.SpawnRadius + FVector(0.0f, 0.0f, 150.0f);
+		Weapons.Add({ Location, (-Location.GetSafeNormal2D()).Rotation() });
+	}
+
+	SpawnedActors.RemoveAll([](const TObjectPtr<AActor>& Actor) { return Actor == nullptr; });
+}
+
+void URPGBenchmarkSubsystem::FireWeapons(float DeltaTime)
+{
+	if (Weapons.IsEmpty() || !LoadedProjectileClass || Config.RoundsPerMinute <= 0.0f)
+	{
+		return;
+	}
+
+	GENLIB_PERF_SCOPE("BenchmarkWeaponFire");
+
+	const float ShotInterval = 60.0f / Config.RoundsPerMinute;
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+
+	for (FBenchmarkWeapon& Weapon : Weapons)
+	{
+		Weapon.TimeSinceLastShot += DeltaTime;
+		while (Weapon.TimeSinceLastShot >= ShotInterval)
+		{
+			Weapon.TimeSinceLastShot -= ShotInterval;
+			GetWorld()->SpawnActor<ARPG_GameProjectile>(LoadedProjectileClass, Weapon.Location, Weapon.Rotation, SpawnParams);
+		}
+	}
+}
+
+void URPGBenchmarkSubsystem::SimulateHits(float DeltaTime)
+{
+	UDamagePipelineSubsystem* DamagePipeline = GetWorld()->GetSubsystem<UDamagePipelineSubsystem>();
+	if (Combatants.IsEmpty() || !DamagePipeline)
+	{
+		return;
+	}
+
+	// Like in a fight, the hits come from a few shooters, so some of them land on the same target in the same frame
+	const int32 NumShooters = FMath::Clamp(Config.NumWeapons, 1, Combatants.Num());
+	PendingHits += Config.HitsPerSecond * DeltaTime;
+	for (; PendingHits >= 1.0f; PendingHits -= 1.0f)
+	{
+		const TWeakObjectPtr<AActor>& Target = Combatants[HitsRandom.RandHelper(Combatants.Num())];
+		const TWeakObjectPtr<AActor>& Instigator = Combatants[HitsRandom.RandHelper(NumShooters)];
+		DamagePipeline->EnqueueDamage({ Target, Instigator, 1.0f, EDamageSource::Hitscan });
+	}
+}
+
+void URPGBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	const double NowSeconds = FPlatformTime::Seconds();
+	const float FrameTimeMs = static_cast<float>((NowSeconds - LastFrameSeconds) * 1000.0);
+	LastFrameSeconds = NowSeconds;
+
+	if (State == EBenchmarkState::Warmup)
+	{
+		if (FrameIndex++ >= Config.WarmupFrames)
+		{
+			State = EBenchmarkState::Measuring;
+			FrameIndex = 0;
+			FGameplayPerfTracker::Get().SetEnabled(true);
+
+			if (const UDamagePipelineSubsystem* DamagePipeline = GetWorld()->GetSubsystem<UDamagePipelineSubsystem>())
+			{
+				DamageRecordsAtStart = DamagePipeline->GetNumRecordsProcessed();
+				DamageEffectsAtStart = DamagePipeline->GetNumEffectsApplied();
+			}
+		}
+	}
+	else
+	{
+		FrameTimesMs.Add(FrameTimeMs);
+		GameThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+		RenderThreadTimesMs.Add(FPlatformTime::ToMilliseconds(GRenderThreadTime));
+		DrawCalls.Add(GNumDrawCallsRHI[0]);
+
+		if (const UProjectileSignificanceSubsystem* ProjectileSignificance = GetWorld()->GetSubsystem<UProjectileSignificanceSubsystem>())
+		{
+			LiveProjectiles.Add(ProjectileSignificance->GetNumProjectiles());
+			for (int32 Level = 0; Level < ProjectilesPerSignificance.Num(); ++Level)
+			{
+				ProjectilesPerSignificance[Level].Add(ProjectileSignificance->GetNumProjectiles(static_cast<EProjectileSignificance>(Level)));
+			}
+		}
+
+		if (++FrameIndex >= Config.NumFrames)
+		{
+			FinishBenchmark();
+			return;
+		}
+	}
+
+	FireWeapons(DeltaTime);
+	SimulateHits(DeltaTime);
+}
+
+TSharedRef<FJsonObject> URPGBenchmarkSubsystem::BuildReport() const
+{
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetObjectField(TEXT("config"), Config.ToJson());
+	Report->SetNumberField(TEXT("measured_frames"), FrameTimesMs.Num());
+	Report->SetObjectField(TEXT("frame_time_ms"), RPGBenchmark::MakeDistribution(FrameTimesMs));
+	Report->SetObjectField(TEXT("game_thread_ms"), RPGBenchmark::MakeDistribution(GameThreadTimesMs));
+	Report->SetObjectField(TEXT("render_thread_ms"), RPGBenchmark::MakeDistribution(RenderThreadTimesMs));
+	Report->SetObjectField(TEXT("draw_calls"), RPGBenchmark::MakeDistribution(DrawCalls));
+
+	// Skinned components of the equipped characters, each one is skinned and drawn on its own
+	int32 SkinnedComponents = 0;
+	for (const AActor* Actor : SpawnedActors)
+	{
+		if (const ARPGBenchmarkEquippedCharacter* Character = Cast<ARPGBenchmarkEquippedCharacter>(Actor))
+		{
+			SkinnedComponents += Character->GetEquipmentComponent()->GetNumSkinnedComponents();
+		}
+	}
+	Report->SetNumberField(TEXT("equipment_skinned_components"), SkinnedComponents);
+
+	// Time per frame and calls per frame of every gameplay scope
+	const double NumFrames = FMath::Max(FrameTimesMs.Num(), 1);
+	TSharedRef<FJsonObject> Scopes = MakeShared<FJsonObject>();
+	for (const TPair<FName, FGameplayPerfTracker::FScopeStats>& Scope : FGameplayPerfTracker::Get().GetScopeStats())
+	{
+		TSharedRef<FJsonObject> ScopeObject = MakeShared<FJsonObject>();
+		ScopeObject->SetNumberField(TEXT("ms_per_frame"), FPlatformTime::ToMilliseconds64(Scope.Value.Cycles) / NumFrames);
+		ScopeObject->SetNumberField(TEXT("calls_per_frame"), Scope.Value.Calls / NumFrames);
+		Scopes->SetObjectField(Scope.Key.ToString(), ScopeObject);
+	}
+	Report->SetObjectField(TEXT("game_thread_scopes"), Scopes);
+
+	// Projectile counts, to relate the cost of the weapons with the amount and detail of the live projectiles
+	TSharedRef<FJsonObject> Projectiles = MakeShared<FJsonObject>();
+	Projectiles->SetObjectField(TEXT("live"), RPGBenchmark::MakeDistribution(LiveProjectiles));
+	Projectiles->SetObjectField(TEXT("high"), RPGBenchmark::MakeDistribution(ProjectilesPerSignificance[static_cast<int32>(EProjectileSignificance::High)]));
+	Projectiles->SetObjectField(TEXT("medium"), RPGBenchmark::MakeDistribution(ProjectilesPerSignificance[static_cast<int32>(EProjectileSignificance::Medium)]));
+	Projectiles->SetObjectField(TEXT("low"), RPGBenchmark::MakeDistribution(ProjectilesPerSignificance[static_cast<int32>(EProjectileSignificance::Low)]));
+	Report->SetObjectField(TEXT("projectiles"), Projectiles);
+
+	// Throughput of the damage pipeline over the measured time
+	if (const UDamagePipelineSubsystem* DamagePipeline = GetWorld()->GetSubsystem<UDamagePipelineSubsystem>())
+	{
+		double MeasuredSeconds = 0.0;
+		for (const float FrameTimeMs : FrameTimesMs)
+		{
+			MeasuredSeconds += FrameTimeMs / 1000.0;
+		}
+		MeasuredSeconds = FMath::Max(MeasuredSeconds, UE_SMALL_NUMBER);
+
+		TSharedRef<FJsonObject> Damage = MakeShared<FJsonObject>();
+		Damage->SetNumberField(TEXT("records_per_second"), (DamagePipeline->GetNumRecordsProcessed() - DamageRecordsAtStart) / MeasuredSeconds);
+		Damage->SetNumberField(TEXT("effects_per_second"), (DamagePipeline->GetNumEffectsApplied() - DamageEffectsAtStart) / MeasuredSeconds);
+		Report->SetObjectField(TEXT("damage"), Damage);
+	}
+
+	// Connections served during the measure, the net tick cost is in the ServerReplicateActors scope
+	if (const UNetDriver* NetDriver = GetWorld()->GetNetDriver(); NetDriver && NetDriver->IsServer())
+	{
+		TSharedRef<FJsonObject> Net = MakeShared<FJsonObject>();
+		Net->SetNumberField(TEXT("client_connections"), NetDriver->ClientConnections.Num());
+		Net->SetBoolField(TEXT("replication_graph"), NetDriver->GetReplicationDriver() != nullptr);
+		Report->SetObjectField(TEXT("net"), Net);
+	}
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("used_physical_mb"), MemoryStats.UsedPhysical / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("peak_used_physical_mb"), MemoryStats.PeakUsedPhysical / (1024.0 * 1024.0));
+	Memory->SetNumberField(TEXT("scenario_delta_mb"), (static_cast<double>(MemoryStats.UsedPhysical) - StartUsedPhysical) / (1024.0 * 1024.0));
+	Report->SetObjectField(TEXT("memory"), Memory);
+
+	return Report;
+}
+
+bool URPGBenchmarkSubsystem::CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline) const
+{
+	bool bRegressed = false;
+	auto CompareValue = [this, &bRegressed](const FString& Label, const double Current, const double Base)
+	{
+		if (Current > Base * (1.0 + Config.RegressionTolerance) && Current - Base > RPGBenchmark::NoiseThresholdMs)
+		{
+			UE_LOG(RPGLog, Error, TEXT("Benchmark regression in %s: %.3f ms, baseline %.3f ms."), *Label, Current, Base);
+			bRegressed = true;
+		}
+	};
+
+	for (const TCHAR* Distribution : { TEXT("frame_time_ms"), TEXT("game_thread_ms"), TEXT("render_thread_ms") })
+	{
+		const TSharedPtr<FJsonObject>* Current;
+		const TSharedPtr<FJsonObject>* Base;
+		if (Report.TryGetObjectField(Distribution, Current) && Baseline.TryGetObjectField(Distribution, Base))
+		{
+			for (const TCHAR* Percentile : { TEXT("p50"), TEXT("p95"), TEXT("p99") })
+			{
+				CompareValue(FString::Printf(TEXT("%s.%s"), Distribution, Percentile), (*Current)->GetNumberField(Percentile), (*Base)->GetNumberField(Percentile));
+			}
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* CurrentScopes;
+	const TSharedPtr<FJsonObject>* BaseScopes;
+	if (Report.TryGetObjectField(TEXT("game_thread_scopes"), CurrentScopes) && Baseline.TryGetObjectField(TEXT("game_thread_scopes"), BaseScopes))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& BaseScope : (*BaseScopes)->Values)
+		{
+			const TSharedPtr<FJsonObject>* CurrentScope;
+			if ((*CurrentScopes)->TryGetObjectField(BaseScope.Key, CurrentScope))
+			{
+				CompareValue(BaseScope.Key, (*CurrentScope)->GetNumberField(TEXT("ms_per_frame")), BaseScope.Value->AsObject()->GetNumberField(TEXT("ms_per_frame")));
+			}
+		}
+	}
+
+	return bRegressed;
+}
+
+void URPGBenchmarkSubsystem::FinishBenchmark()
+{
+	State = EBenchmarkState::Idle;
+
+	const TSharedRef<FJsonObject> Report = BuildReport();
+	FGameplayPerfTracker::Get().SetEnabled(false);
+	RestoreConsoleVariables();
+
+	ReportPath = RPGBenchmark::GetBenchmarkDir() / FString::Printf(TEXT("%s_%s.json"), *Config.Name, *FDateTime::Now().ToString());
+	RPGBenchmark::SaveJson(Report, ReportPath);
+	UE_LOG(RPGLog, Display, TEXT("Benchmark %s finished, report written to %s"), *Config.Name, *ReportPath);
+
+	const FString BaselinePath = RPGBenchmark::GetBaselinePath(Config);
+	if (FParse::Param(FCommandLine::Get(), TEXT("BenchUpdateBaseline")))
+	{
+		RPGBenchmark::SaveJson(Report, BaselinePath);
+		UE_LOG(RPGLog, Display, TEXT("Benchmark baseline updated: %s"), *BaselinePath);
+	}
+	else if (const TSharedPtr<FJsonObject> Baseline = RPGBenchmark::LoadJson(BaselinePath))
+	{
+		bLastRunRegressed = CompareWithBaseline(*Report, *Baseline);
+		UE_LOG(RPGLog, Display, TEXT("Benchmark %s compared with %s: %s"), *Config.Name, *BaselinePath, bLastRunRegressed ? TEXT("REGRESSION") : TEXT("OK"));
+	}
+	else
+	{
+		UE_LOG(RPGLog, Warning, TEXT("No benchmark baseline found at %s, nothing to compare."), *BaselinePath);
+	}
+
+	for (AActor* Actor : SpawnedActors)
+	{
+		if (IsValid(Actor))
+		{
+			Actor->Destroy();
+		}
+	}
+	SpawnedActors.Reset();
+	Weapons.Reset();
+	Combatants.Reset();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, bLastRunRegressed ? 1 : 0);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkRunCommand(
+	TEXT("RPG.Bench.Run"),
+	TEXT("Runs the gameplay benchmark. Usage: RPG.Bench.Run [BenchInteractors=16] [BenchInteractables=1000] [BenchItems=1000] [BenchWeapons=8] [BenchRPM=600] [BenchProjectileLOD=1] [BenchCombatants=0] [BenchEquipped=0] [BenchFrames=600] ..."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		URPGBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<URPGBenchmarkSubsystem>() : nullptr;
+		if (!Benchmark)
+		{
+			UE_LOG(RPGLog, Error, TEXT("RPG.Bench.Run needs a game world."));
+			return;
+		}
+
+		FRPGBenchmarkConfig BenchmarkConfig;
+		BenchmarkConfig.Parse(*FString::Join(Args, TEXT(" ")));
+		Benchmark->StartBenchmark(BenchmarkConfig, false);
+	}));
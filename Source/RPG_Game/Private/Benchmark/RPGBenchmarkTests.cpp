@@ -0,0 +1,159 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Benchmark/RPGBenchmarkSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace RPGBenchmarkTests
+{
+	// Seconds a scenario may run before the test fails, warmup included
+	static constexpr double TimeoutSeconds = 600.0;
+
+	// Actors spawned by a scenario, every count is given so the defaults of the config never leak in
+	struct FScenario
+	{
+		const TCHAR* Name;
+		int32 NumInteractors;
+		int32 NumInteractables;
+		int32 NumItems;
+		int32 NumWeapons;
+		int32 NumCombatants;
+		int32 NumEquippedCharacters;
+	};
+
+	static const FScenario Scenarios[] =
+	{
+		{ TEXT("Interaction"), 16, 1000, 0, 0, 0, 0 },
+		{ TEXT("Items"), 0, 0, 1000, 0, 0, 0 },
+		{ TEXT("Projectiles"), 0, 0, 0, 67, 0, 0 },
+		{ TEXT("Damage"), 0, 0, 0, 0, 200, 0 },
+		{ TEXT("Equipment"), 0, 0, 0, 0, 0, 100 },
+	};
+
+	static FString MakeCommand(const FScenario& Scenario)
+	{
+		return FString::Printf(TEXT("BenchName=%s BenchInteractors=%d BenchInteractables=%d BenchItems=%d BenchWeapons=%d BenchRPM=600 BenchCombatants=%d BenchEquipped=%d"),
+			Scenario.Name, Scenario.NumInteractors, Scenario.NumInteractables, Scenario.NumItems, Scenario.NumWeapons, Scenario.NumCombatants, Scenario.NumEquippedCharacters);
+	}
+
+	static const FScenario* FindScenario(const FString& Name)
+	{
+		for (const FScenario& Scenario : Scenarios)
+		{
+			if (Name == Scenario.Name)
+			{
+				return &Scenario;
+			}
+		}
+		return nullptr;
+	}
+
+	static UWorld* FindGameWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::Game || Context.WorldType == EWorldType::PIE) && Context.World() && Context.World()->HasBegunPlay())
+			{
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+}
+
+// Waits for the benchmark to finish and reports its comparison with the baseline
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FWaitForRPGBenchmarkCommand, TWeakObjectPtr<URPGBenchmarkSubsystem>, Benchmark, FAutomationTestBase*, Test);
+
+bool FWaitForRPGBenchmarkCommand::Update()
+{
+	URPGBenchmarkSubsystem* BenchmarkSubsystem = Benchmark.Get();
+	if (!BenchmarkSubsystem)
+	{
+		Test->AddError(TEXT("The world of the benchmark was destroyed before it finished."));
+		return true;
+	}
+
+	if (BenchmarkSubsystem->IsRunning())
+	{
+		if (GetCurrentRunTime() > RPGBenchmarkTests::TimeoutSeconds)
+		{
+			Test->AddError(TEXT("The benchmark timed out."));
+			return true;
+		}
+		return false;
+	}
+
+	Test->AddInfo(FString::Printf(TEXT("Report: %s"), *BenchmarkSubsystem->GetReportPath()));
+	Test->TestFalse(TEXT("Regression over the baseline"), BenchmarkSubsystem->HasRegressed());
+	return true;
+}
+
+/**
+ * Runs every scenario of the gameplay benchmark against its baseline, in the game world already loaded.
+ * The scenarios are the ones of RPG.Bench.Run, isolated so a regression points to a single system.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FRPGBenchmarkTest, "RPG.Benchmark", EAutomationTestFlags::ClientContext | EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FRPGBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const RPGBenchmarkTests::FScenario& Scenario : RPGBenchmarkTests::Scenarios)
+	{
+		OutBeautifiedNames.Add(Scenario.Name);
+		OutTestCommands.Add(RPGBenchmarkTests::MakeCommand(Scenario));
+	}
+}
+
+bool FRPGBenchmarkTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = RPGBenchmarkTests::FindGameWorld();
+	URPGBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<URPGBenchmarkSubsystem>() : nullptr;
+	if (!Benchmark)
+	{
+		AddError(TEXT("The benchmark needs a game or PIE world playing."));
+		return false;
+	}
+
+	FRPGBenchmarkConfig Config;
+	Config.Parse(*Parameters);
+
+	// A count lost in the parsing would measure an empty world and pass against an empty baseline
+	const RPGBenchmarkTests::FScenario* Scenario = RPGBenchmarkTests::FindScenario(Config.Name);
+	if (!Scenario)
+	{
+		AddError(FString::Printf(TEXT("Unknown scenario %s."), *Config.Name));
+		return false;
+	}
+	const bool bParsed = TestEqual(TEXT("BenchInteractors"), Config.NumInteractors, Scenario->NumInteractors)
+		& TestEqual(TEXT("BenchInteractables"), Config.NumInteractables, Scenario->NumInteractables)
+		& TestEqual(TEXT("BenchItems"), Config.NumItems, Scenario->NumItems)
+		& TestEqual(TEXT("BenchWeapons"), Config.NumWeapons, Scenario->NumWeapons)
+		& TestEqual(TEXT("BenchCombatants"), Config.NumCombatants, Scenario->NumCombatants)
+		& TestEqual(TEXT("BenchEquipped"), Config.NumEquippedCharacters, Scenario->NumEquippedCharacters);
+	const int32 NumSpawned = Config.NumInteractors + Config.NumInteractables + Config.NumItems + Config.NumWeapons + Config.NumCombatants + Config.NumEquippedCharacters;
+	if (!bParsed || !TestTrue(TEXT("The scenario spawns actors"), NumSpawned > 0))
+	{
+		return false;
+	}
+
+	// A scenario without its assets measures nothing
+	const FString MissingSetup = Benchmark->GetMissingSetup(Config);
+	if (!MissingSetup.IsEmpty())
+	{
+		AddInfo(FString::Printf(TEXT("Skipped %s"), *MissingSetup));
+		return true;
+	}
+
+	if (!Benchmark->StartBenchmark(Config, false))
+	{
+		AddError(TEXT("Another benchmark is already running."));
+		return false;
+	}
+
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForRPGBenchmarkCommand(Benchmark, this));
+	return true;
+}
+
+#endif
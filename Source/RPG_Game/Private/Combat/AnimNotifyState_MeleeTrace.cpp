@@ -0,0 +1,32 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/AnimNotifyState_MeleeTrace.h"
+#include "Combat/MeleeTraceComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+void UAnimNotifyState_MeleeTrace::NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference)
+{
+	Super::NotifyBegin(MeshComp, Animation, TotalDuration, EventReference);
+
+	const AActor* Owner = MeshComp ? MeshComp->GetOwner() : nullptr;
+	if (UMeleeTraceComponent* MeleeTrace = Owner ? Owner->FindComponentByClass<UMeleeTraceComponent>() : nullptr)
+	{
+		MeleeTrace->BeginSwing();
+	}
+}
+
+void UAnimNotifyState_MeleeTrace::NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference)
+{
+	const AActor* Owner = MeshComp ? MeshComp->GetOwner() : nullptr;
+	if (UMeleeTraceComponent* MeleeTrace = Owner ? Owner->FindComponentByClass<UMeleeTraceComponent>() : nullptr)
+	{
+		MeleeTrace->EndSwing();
+	}
+
+	Super::NotifyEnd(MeshComp, Animation, EventReference);
+}
+
+FString UAnimNotifyState_MeleeTrace::GetNotifyName_Implementation() const
+{
+	return TEXT("Melee Trace");
+}
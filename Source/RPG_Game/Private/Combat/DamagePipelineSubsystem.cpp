@@ -0,0 +1,127 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/DamagePipelineSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "Abilities/RPGDamageEffect.h"
+#include "Core/RPGGameplayTags.h"
+#include "AbilitySystemComponent.h"
+#include "AbilitySystemGlobals.h"
+#include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+
+DECLARE_CYCLE_STAT(TEXT("Damage Pipeline Process"), STAT_DamagePipelineProcess, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Records"), STAT_DamageRecords, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Damage Effects Applied"), STAT_DamageEffectsApplied, STATGROUP_RPGCombat);
+
+void UDamagePipelineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The tickable subsystems, like the hitscan one, tick before this delegate, so their hits are applied in the same frame
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UDamagePipelineSubsystem::HandleWorldPostActorTick);
+}
+
+void UDamagePipelineSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+	PendingRecords.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDamagePipelineSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	LoadedDamageEffectClass = DamageEffectClass.IsNull() ? URPGDamageEffect::StaticClass() : DamageEffectClass.LoadSynchronous();
+	if (!LoadedDamageEffectClass)
+	{
+		UE_LOG(RPGLog, Error, TEXT("Damage effect class %s could not be loaded. %s"), *DamageEffectClass.ToString(), *RPG_LOGS_LINE);
+	}
+}
+
+void UDamagePipelineSubsystem::EnqueueDamage(const FDamageRecord& Record)
+{
+	// The server owns the attributes
+	if (Record.Amount <= 0.0f || !Record.Target.IsValid() || GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	PendingRecords.Add(Record);
+}
+
+void UDamagePipelineSubsystem::HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime)
+{
+	if (World == GetWorld() && !PendingRecords.IsEmpty())
+	{
+		ProcessQueue();
+	}
+}
+
+void UDamagePipelineSubsystem::ProcessQueue()
+{
+	SCOPE_CYCLE_COUNTER(STAT_DamagePipelineProcess);
+	GENLIB_PERF_SCOPE("DamagePipeline");
+	INC_DWORD_STAT_BY(STAT_DamageRecords, PendingRecords.Num());
+
+	// Sorting puts the hits of an instigator on a target next to each other, so they merge in a single pass
+	PendingRecords.Sort([](const FDamageRecord& A, const FDamageRecord& B)
+	{
+		const AActor* TargetA = A.Target.Get();
+		const AActor* TargetB = B.Target.Get();
+		return TargetA != TargetB ? TargetA < TargetB : A.Instigator.Get() < B.Instigator.Get();
+	});
+
+	int32 EffectsApplied = 0;
+	for (int32 First = 0; First < PendingRecords.Num();)
+	{
+		AActor* Target = PendingRecords[First].Target.Get();
+		AActor* Instigator = PendingRecords[First].Instigator.Get();
+
+		float Amount = 0.0f;
+		int32 Last = First;
+		for (; Last < PendingRecords.Num() && PendingRecords[Last].Target.Get() == Target && PendingRecords[Last].Instigator.Get() == Instigator; ++Last)
+		{
+			Amount += PendingRecords[Last].Amount;
+		}
+
+		// Targets destroyed during the frame are skipped
+		if (Target && ApplyDamage(Target, Instigator, Amount))
+		{
+			++EffectsApplied;
+		}
+		First = Last;
+	}
+
+	INC_DWORD_STAT_BY(STAT_DamageEffectsApplied, EffectsApplied);
+	NumRecordsProcessed += PendingRecords.Num();
+	NumEffectsApplied += EffectsApplied;
+	PendingRecords.Reset();
+}
+
+bool UDamagePipelineSubsystem::ApplyDamage(AActor* Target, AActor* Instigator, float Amount) const
+{
+	UAbilitySystemComponent* TargetAbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Target);
+	if (!TargetAbilitySystem || !LoadedDamageEffectClass)
+	{
+		return false;
+	}
+
+	// The spec comes from the instigator when it has an ability system, so its effects and tags can modify the damage
+	UAbilitySystemComponent* SourceAbilitySystem = UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(Instigator);
+	UAbilitySystemComponent* SpecOwner = SourceAbilitySystem ? SourceAbilitySystem : TargetAbilitySystem;
+
+	FGameplayEffectContextHandle Context = SpecOwner->MakeEffectContext();
+	Context.AddInstigator(Instigator, Instigator);
+
+	const FGameplayEffectSpecHandle Spec = SpecOwner->MakeOutgoingSpec(LoadedDamageEffectClass, 1.0f, Context);
+	if (!Spec.IsValid())
+	{
+		return false;
+	}
+
+	Spec.Data->SetSetByCallerMagnitude(RPGGameplayTags::SetByCaller_Damage, Amount);
+	TargetAbilitySystem->ApplyGameplayEffectSpecToSelf(*Spec.Data.Get());
+	return true;
+}
@@ -0,0 +1,165 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/HitscanSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "RPG_Game/RPG_GameProjectile.h"
+#include "Combat/LagCompensationSubsystem.h"
+#include "Combat/DamagePipelineSubsystem.h"
+#include "GameFramework/Character.h"
+#include "GameplayPerfTracker.h"
+#include "Engine/World.h"
+#include "DrawDebugHelpers.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/LowLevelMemTracker.h"
+
+DECLARE_CYCLE_STAT(TEXT("Hitscan Resolve Shots"), STAT_HitscanResolveShots, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitscan Shots"), STAT_HitscanShots, STATGROUP_RPGCombat);
+
+// Heap traffic of the shot resolution on the game thread
+LLM_DEFINE_TAG(HitscanResolve);
+
+static bool GHitscanDebug = false;
+static FAutoConsoleVariableRef CVarHitscanDebug(
+	TEXT("RPG.Hitscan.Debug"),
+	GHitscanDebug,
+	TEXT("Draws the traces and hits of the hitscan shots."));
+
+// Distance moved past the exit point of a penetrated surface before tracing again
+static constexpr float PenetrationExitOffset = 0.1f;
+
+TStatId UHitscanSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UHitscanSubsystem, STATGROUP_Tickables);
+}
+
+void UHitscanSubsystem::QueueShot(const FHitscanShot& Shot)
+{
+	PendingShots.Add(Shot);
+}
+
+void UHitscanSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!PendingShots.IsEmpty())
+	{
+		ResolveShots();
+	}
+}
+
+void UHitscanSubsystem::ResolveShots()
+{
+	SCOPE_CYCLE_COUNTER(STAT_HitscanResolveShots);
+	GENLIB_PERF_SCOPE("HitscanResolve");
+	LLM_SCOPE_BYTAG(HitscanResolve);
+	INC_DWORD_STAT_BY(STAT_HitscanShots, PendingShots.Num());
+
+	const UWorld* World = GetWorld();
+	const ULagCompensationSubsystem* LagCompensation = World->GetSubsystem<ULagCompensationSubsystem>();
+	CompensatedActors.Reset();
+	if (LagCompensation)
+	{
+		LagCompensation->GetCompensatedActors(CompensatedActors);
+	}
+
+	// The scene and the hitbox history are only read during the traces, so every shot can be traced on a different thread
+	ShotHits.SetNum(PendingShots.Num(), EAllowShrinking::No);
+	ParallelFor(PendingShots.Num(), [this, World, LagCompensation](int32 Index)
+	{
+		ShotHits[Index].Reset();
+		TraceShot(World, LagCompensation, CompensatedActors, PendingShots[Index], ShotHits[Index]);
+	});
+
+	// Apply the hits on the game thread
+	UDamagePipelineSubsystem* DamagePipeline = World->GetSubsystem<UDamagePipelineSubsystem>();
+	for (int32 Index = 0; Index < PendingShots.Num(); ++Index)
+	{
+		const FHitscanShot& Shot = PendingShots[Index];
+		for (const FHitResult& Hit : ShotHits[Index])
+		{
+			ARPG_GameProjectile::ApplyHitImpulse(Shot.Instigator.Get(), Hit.GetActor(), Hit.GetComponent(), Shot.Direction * Shot.ImpulseSpeed, Hit.ImpactPoint);
+
+			if (DamagePipeline)
+			{
+				DamagePipeline->EnqueueDamage({ Hit.GetActor(), Shot.Instigator, Shot.Damage, EDamageSource::Hitscan });
+			}
+
+			if (GHitscanDebug)
+			{
+				DrawDebugLine(World, Hit.TraceStart, Hit.ImpactPoint, FColor::Red, false, 1.0f);
+				DrawDebugPoint(World, Hit.ImpactPoint, 8.0f, FColor::Yellow, false, 1.0f);
+			}
+		}
+
+		if (GHitscanDebug && ShotHits[Index].IsEmpty())
+		{
+			DrawDebugLine(World, Shot.Start, Shot.Start + Shot.Direction * Shot.Range, FColor::Green, false, 1.0f);
+		}
+	}
+
+	PendingShots.Reset();
+}
+
+/**
+ * Traces a shot against the scene. After every blocking hit, a trace from the far side of the surface
+ * (at MaxPenetrationThickness) back to the impact point looks for the exit point. If the surface is thin
+ * enough to find it, the shot continues from there until the range or the hits budget is spent.
+ * For a rewound shot the scene traces ignore the characters, and every segment is traced against their rewound
+ * capsules up to the surface hit. A character hit stops the shot.
+ */
+void UHitscanSubsystem::TraceShot(const UWorld* World, const ULagCompensationSubsystem* LagCompensation, const TArray<AActor*>& CompensatedActors,
+	const FHitscanShot& Shot, TArray<FHitResult, TInlineAllocator<4>>& OutHits)
+{
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(HitscanShot), false, Shot.Instigator.Get());
+	QueryParams.bReturnPhysicalMaterial = true;
+
+	const bool bRewind = LagCompensation && Shot.RewindTime >= 0.0;
+	if (bRewind)
+	{
+		QueryParams.AddIgnoredActors(CompensatedActors);
+	}
+
+	FVector Start = Shot.Start;
+	float RemainingRange = Shot.Range;
+
+	while (OutHits.Num() < Shot.MaxHits && RemainingRange > 0.0f)
+	{
+		const FVector End = Start + Shot.Direction * RemainingRange;
+		FHitResult Hit;
+		const bool bHitScene = World->LineTraceSingleByChannel(Hit, Start, End, Shot.TraceChannel, QueryParams);
+
+		FHitResult CharacterHit;
+		if (bRewind && LagCompensation->TraceRewound(Shot.RewindTime, Start, bHitScene ? Hit.ImpactPoint : End, Shot.Instigator.Get(), CharacterHit))
+		{
+			CharacterHit.TraceEnd = End;
+			OutHits.Add(CharacterHit);
+			break;
+		}
+
+		if (!bHitScene)
+		{
+			break;
+		}
+		OutHits.Add(Hit);
+		RemainingRange -= Hit.Distance;
+
+		UPrimitiveComponent* HitComponent = Hit.GetComponent();
+		if (Shot.MaxPenetrationThickness <= 0.0f || !HitComponent)
+		{
+			break;
+		}
+
+		// A trace starting inside the surface doesn't hit it, so finding the exit means the surface is thin enough
+		FHitResult ExitHit;
+		const FVector ProbeStart = Hit.ImpactPoint + Shot.Direction * Shot.MaxPenetrationThickness;
+		if (!HitComponent->LineTraceComponent(ExitHit, ProbeStart, Hit.ImpactPoint, FCollisionQueryParams(SCENE_QUERY_STAT(HitscanPenetration), false)))
+		{
+			break;
+		}
+
+		const float Thickness = FVector::Dist(Hit.ImpactPoint, ExitHit.ImpactPoint);
+		Start = ExitHit.ImpactPoint + Shot.Direction * PenetrationExitOffset;
+		RemainingRange -= Thickness + PenetrationExitOffset;
+	}
+}
@@ -0,0 +1,286 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/LagCompensationSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "GameplayPerfTracker.h"
+#include "GameFramework/Character.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Record"), STAT_LagCompensationRecord, STATGROUP_RPGCombat);
+DECLARE_CYCLE_STAT(TEXT("Lag Compensation Validate"), STAT_LagCompensationValidate, STATGROUP_RPGCombat);
+
+FHitboxSnapshot FHitboxSnapshot::Interpolate(const FHitboxSnapshot& A, const FHitboxSnapshot& B, float Alpha)
+{
+	FHitboxSnapshot Result = A;
+	Result.Time = FMath::Lerp(A.Time, B.Time, static_cast<double>(Alpha));
+	Result.CapsuleCenter = FMath::Lerp(A.CapsuleCenter, B.CapsuleCenter, static_cast<double>(Alpha));
+	Result.CapsuleRotation = FQuat4f::Slerp(A.CapsuleRotation, B.CapsuleRotation, Alpha);
+	Result.CapsuleRadius = FMath::Lerp(A.CapsuleRadius, B.CapsuleRadius, Alpha);
+	Result.CapsuleHalfHeight = FMath::Lerp(A.CapsuleHalfHeight, B.CapsuleHalfHeight, Alpha);
+	return Result;
+}
+
+void FHitboxHistory::Init(int32 InCapacity)
+{
+	Snapshots.SetNum(FMath::Max(InCapacity, 2));
+	Reset();
+}
+
+void FHitboxHistory::Push(const FHitboxSnapshot& Snapshot)
+{
+	Snapshots[Head] = Snapshot;
+	Head = (Head + 1) % Snapshots.Num();
+	Num = FMath::Min(Num + 1, Snapshots.Num());
+}
+
+bool FHitboxHistory::Rewind(double Time, FHitboxSnapshot& OutSnapshot) const
+{
+	if (Num == 0)
+	{
+		return false;
+	}
+
+	if (Time <= Get(0).Time)
+	{
+		OutSnapshot = Get(0);
+		return true;
+	}
+	if (Time >= Get(Num - 1).Time)
+	{
+		OutSnapshot = Get(Num - 1);
+		return true;
+	}
+
+	// Search from the newest snapshot, the rewound times are usually recent
+	for (int32 Index = Num - 1; Index > 0; --Index)
+	{
+		const FHitboxSnapshot& Older = Get(Index - 1);
+		if (Older.Time <= Time)
+		{
+			const FHitboxSnapshot& Newer = Get(Index);
+			const double Span = Newer.Time - Older.Time;
+			const float Alpha = Span > UE_DOUBLE_SMALL_NUMBER ? static_cast<float>((Time - Older.Time) / Span) : 1.0f;
+			OutSnapshot = FHitboxSnapshot::Interpolate(Older, Newer, Alpha);
+			return true;
+		}
+	}
+
+	OutSnapshot = Get(0);
+	return true;
+}
+
+void ULagCompensationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TrackedCharacters.Reserve(ExpectedCharacters);
+
+	// The two snapshots around the oldest rewound time must both be kept
+	SnapshotRate = FMath::Max(SnapshotRate, 1.0f);
+	HistoryCapacity = FMath::CeilToInt32(MaxRewindTime * SnapshotRate) + 2;
+}
+
+void ULagCompensationSubsystem::Deinitialize()
+{
+	TrackedCharacters.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId ULagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+void ULagCompensationSubsystem::RegisterCharacter(ACharacter* Character)
+{
+	if (!Character || FindTracked(Character))
+	{
+		return;
+	}
+
+	FTrackedCharacter& Tracked = TrackedCharacters.AddDefaulted_GetRef();
+	Tracked.Character = Character;
+	Tracked.History.Init(HistoryCapacity);
+}
+
+void ULagCompensationSubsystem::UnregisterCharacter(ACharacter* Character)
+{
+	const int32 Index = TrackedCharacters.IndexOfByPredicate([Character](const FTrackedCharacter& Tracked) { return Tracked.Character == Character; });
+	if (Index != INDEX_NONE)
+	{
+		TrackedCharacters.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+void ULagCompensationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	// Only the server validates hits
+	if (GetWorld()->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationRecord);
+	GENLIB_PERF_SCOPE("LagCompensationRecord");
+
+	// A server ticking faster than SnapshotRate would cover less than MaxRewindTime with the same history
+	const double Time = GetWorld()->GetTimeSeconds();
+	if (Time - LastSnapshotTime < 1.0 / SnapshotRate)
+	{
+		return;
+	}
+	LastSnapshotTime = Time;
+
+	for (FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		RecordSnapshot(Tracked, Time);
+	}
+}
+
+void ULagCompensationSubsystem::RecordSnapshot(FTrackedCharacter& Tracked, double Time) const
+{
+	const ACharacter* Character = Tracked.Character.Get();
+	if (!Character)
+	{
+		return;
+	}
+
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+
+	FHitboxSnapshot Snapshot;
+	Snapshot.Time = Time;
+	Snapshot.CapsuleCenter = Capsule->GetComponentLocation();
+	Snapshot.CapsuleRotation = FQuat4f(Capsule->GetComponentQuat());
+	Snapshot.CapsuleRadius = Capsule->GetScaledCapsuleRadius();
+	Snapshot.CapsuleHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+	Tracked.History.Push(Snapshot);
+}
+
+const ULagCompensationSubsystem::FTrackedCharacter* ULagCompensationSubsystem::FindTracked(const ACharacter* Character) const
+{
+	return TrackedCharacters.FindByPredicate([Character](const FTrackedCharacter& Tracked) { return Tracked.Character == Character; });
+}
+
+namespace LagCompensation
+{
+	// Distance along a normalized ray to the surface of a sphere, negative if missed
+	static double IntersectSphere(const FVector& Origin, const FVector& Direction, const FVector& Center, double Radius)
+	{
+		const FVector ToOrigin = Origin - Center;
+		const double B = FVector::DotProduct(Direction, ToOrigin);
+		const double C = ToOrigin.SizeSquared() - Radius * Radius;
+		const double H = B * B - C;
+		return H >= 0.0 ? -B - FMath::Sqrt(H) : -1.0;
+	}
+
+	// Distance along a normalized ray to the surface of a capsule of axis A-B, negative if missed
+	static double IntersectCapsule(const FVector& Origin, const FVector& Direction, const FVector& A, const FVector& B, double Radius)
+	{
+		const FVector Axis = B - A;
+		const FVector ToOrigin = Origin - A;
+		const double AxisSquared = Axis.SizeSquared();
+		const double AxisDotDirection = FVector::DotProduct(Axis, Direction);
+		const double AxisDotOrigin = FVector::DotProduct(Axis, ToOrigin);
+
+		// Cylinder of the body, the ray parallel to the axis can only enter through the caps
+		const double QuadA = AxisSquared - AxisDotDirection * AxisDotDirection;
+		if (QuadA > UE_DOUBLE_SMALL_NUMBER)
+		{
+			const double QuadB = AxisSquared * FVector::DotProduct(Direction, ToOrigin) - AxisDotOrigin * AxisDotDirection;
+			const double QuadC = AxisSquared * ToOrigin.SizeSquared() - AxisDotOrigin * AxisDotOrigin - Radius * Radius * AxisSquared;
+			const double H = QuadB * QuadB - QuadA * QuadC;
+			if (H < 0.0)
+			{
+				return -1.0;
+			}
+
+			const double Distance = (-QuadB - FMath::Sqrt(H)) / QuadA;
+			const double AlongAxis = AxisDotOrigin + Distance * AxisDotDirection;
+			if (AlongAxis > 0.0 && AlongAxis < AxisSquared)
+			{
+				return Distance;
+			}
+		}
+
+		// The ray enters through one of the hemispheres
+		const double DistanceA = IntersectSphere(Origin, Direction, A, Radius);
+		const double DistanceB = IntersectSphere(Origin, Direction, B, Radius);
+		if (DistanceA < 0.0 || DistanceB < 0.0)
+		{
+			return FMath::Max(DistanceA, DistanceB);
+		}
+		return FMath::Min(DistanceA, DistanceB);
+	}
+}
+
+bool ULagCompensationSubsystem::TraceRewound(double Time, const FVector& Start, const FVector& End, const AActor* IgnoredActor, FHitResult& OutHit) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_LagCompensationValidate);
+
+	const FVector Segment = End - Start;
+	const double Length = Segment.Size();
+	if (Length <= UE_DOUBLE_SMALL_NUMBER)
+	{
+		return false;
+	}
+	const FVector Direction = Segment / Length;
+
+	// A client can't claim a time in the future of the server, nor further in the past than allowed
+	const double Now = GetWorld()->GetTimeSeconds();
+	Time = FMath::Clamp(Time, Now - MaxRewindTime, Now);
+
+	double NearestDistance = Length;
+	const FTrackedCharacter* NearestTracked = nullptr;
+	FHitboxSnapshot NearestSnapshot;
+	for (const FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		const ACharacter* Character = Tracked.Character.Get();
+		FHitboxSnapshot Snapshot;
+		if (!Character || Character == IgnoredActor || !Tracked.History.Rewind(Time, Snapshot))
+		{
+			continue;
+		}
+
+		const FVector Axis = FVector(Snapshot.CapsuleRotation.GetUpVector()) * FMath::Max(Snapshot.CapsuleHalfHeight - Snapshot.CapsuleRadius, 0.0f);
+		const double Distance = LagCompensation::IntersectCapsule(Start, Direction, Snapshot.CapsuleCenter - Axis, Snapshot.CapsuleCenter + Axis, Snapshot.CapsuleRadius);
+		if (Distance >= 0.0 && Distance < NearestDistance)
+		{
+			NearestDistance = Distance;
+			NearestTracked = &Tracked;
+			NearestSnapshot = Snapshot;
+		}
+	}
+
+	if (!NearestTracked)
+	{
+		return false;
+	}
+
+	ACharacter* Character = NearestTracked->Character.Get();
+	const FVector ImpactPoint = Start + Direction * NearestDistance;
+	const FVector Axis = FVector(NearestSnapshot.CapsuleRotation.GetUpVector()) * FMath::Max(NearestSnapshot.CapsuleHalfHeight - NearestSnapshot.CapsuleRadius, 0.0f);
+	const FVector AxisPoint = FMath::ClosestPointOnSegment(ImpactPoint, NearestSnapshot.CapsuleCenter - Axis, NearestSnapshot.CapsuleCenter + Axis);
+
+	OutHit = FHitResult(Character, Character->GetCapsuleComponent(), ImpactPoint, (ImpactPoint - AxisPoint).GetSafeNormal());
+	OutHit.bBlockingHit = true;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Distance = static_cast<float>(NearestDistance);
+	OutHit.Time = static_cast<float>(NearestDistance / Length);
+	return true;
+}
+
+void ULagCompensationSubsystem::GetCompensatedActors(TArray<AActor*>& OutActors) const
+{
+	for (const FTrackedCharacter& Tracked : TrackedCharacters)
+	{
+		if (ACharacter* Character = Tracked.Character.Get())
+		{
+			OutActors.Add(Character);
+		}
+	}
+}
@@ -0,0 +1,319 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/MeleeTraceComponent.h"
+#include "RPG_Game/RPG_Game.h"
+#include "RPG_Game/RPG_GameProjectile.h"
+#include "Combat/DamagePipelineSubsystem.h"
+#include "UtilsLib.h"
+#include "GameplayPerfTracker.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Animation/AnimSequence.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "DrawDebugHelpers.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Melee Trace"), STAT_MeleeTrace, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Melee Sweeps"), STAT_MeleeSweeps, STATGROUP_RPGCombat);
+
+static bool GMeleeDebug = false;
+static FAutoConsoleVariableRef CVarMeleeDebug(
+	TEXT("RPG.Melee.Debug"),
+	GMeleeDebug,
+	TEXT("Draws the blade samples and the hits of the melee swings."));
+
+namespace MeleeTrace
+{
+	// Position of a socket in component space in the pose of an animation
+	static FVector EvaluateSocketLocation(const UAnimSequence& Sequence, const TArrayView<const int32> SkeletonBoneIndices,
+		const TArrayView<const FTransform> RefPose, const FTransform& SocketLocalTransform, const double AnimTime)
+	{
+		const FAnimExtractContext ExtractionContext(AnimTime);
+		FTransform ComponentTransform = SocketLocalTransform;
+		for (int32 Index = 0; Index < SkeletonBoneIndices.Num(); ++Index)
+		{
+			FTransform BoneTransform = RefPose[Index];
+			if (SkeletonBoneIndices[Index] != INDEX_NONE)
+			{
+				Sequence.GetBoneTransform(BoneTransform, FSkeletonPoseBoneIndex(SkeletonBoneIndices[Index]), ExtractionContext, false);
+			}
+			ComponentTransform *= BoneTransform;
+		}
+		return ComponentTransform.GetLocation();
+	}
+}
+
+UMeleeTraceComponent::UMeleeTraceComponent()
+{
+	// The blade is sampled after the animation of the frame is done
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UMeleeTraceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!TracedMesh)
+	{
+		SetTracedMesh(GetOwner()->FindComponentByClass<USkeletalMeshComponent>());
+	}
+}
+
+void UMeleeTraceComponent::SetTracedMesh(UMeshComponent* InMesh)
+{
+	if (TracedMesh)
+	{
+		RemoveTickPrerequisiteComponent(TracedMesh);
+	}
+
+	TracedMesh = InMesh;
+	ChainAnimation.Reset();
+	bChainsValid = false;
+
+	if (TracedMesh)
+	{
+		AddTickPrerequisiteComponent(TracedMesh);
+	}
+}
+
+void UMeleeTraceComponent::BeginSwing()
+{
+	// The hits are only resolved by the authority
+	if (!GetOwner()->HasAuthority())
+	{
+		return;
+	}
+
+	if (!TracedMesh)
+	{
+		UE_LOG(RPGLog, Warning, TEXT("%s has no mesh to trace the melee swing. %s"), *GetOwner()->GetName(), *RPG_LOGS_LINE);
+		return;
+	}
+
+	bSwinging = true;
+	SwingHitActors.Reset();
+	PreviousBlade = GetCurrentBlade();
+	PreviousComponentTransform = TracedMesh->GetComponentTransform();
+
+	SampledMontage.Reset();
+	const USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(TracedMesh);
+	if (const UAnimInstance* AnimInstance = SkeletalMesh ? SkeletalMesh->GetAnimInstance() : nullptr)
+	{
+		SampledMontage = AnimInstance->GetCurrentActiveMontage();
+		PreviousMontagePosition = SampledMontage.IsValid() ? AnimInstance->Montage_GetPosition(SampledMontage.Get()) : 0.0f;
+	}
+
+	SetComponentTickEnabled(true);
+}
+
+void UMeleeTraceComponent::EndSwing()
+{
+	bSwinging = false;
+	SetComponentTickEnabled(false);
+}
+
+UMeleeTraceComponent::FBladeSample UMeleeTraceComponent::GetCurrentBlade() const
+{
+	return { TracedMesh->GetSocketLocation(BaseSocketName), TracedMesh->GetSocketLocation(TipSocketName) };
+}
+
+void UMeleeTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!bSwinging || !TracedMesh)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_MeleeTrace);
+	GENLIB_PERF_SCOPE("MeleeTrace");
+
+	const FBladeSample CurrentBlade = GetCurrentBlade();
+	const FTransform CurrentComponentTransform = TracedMesh->GetComponentTransform();
+
+	// The same samples per second at any tick rate, a slow server runs more sub-steps per frame
+	const int32 NumSubSteps = FMath::Clamp(FMath::CeilToInt32(DeltaTime * SamplesPerSecond), 1, MaxSubSteps);
+
+	const UAnimMontage* Montage = nullptr;
+	float MontagePosition = 0.0f;
+	const USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(TracedMesh);
+	if (const UAnimInstance* AnimInstance = SkeletalMesh ? SkeletalMesh->GetAnimInstance() : nullptr)
+	{
+		Montage = AnimInstance->GetCurrentActiveMontage();
+		MontagePosition = Montage ? AnimInstance->Montage_GetPosition(Montage) : 0.0f;
+	}
+
+	// The montage is evaluated only while it plays forward from the previous frame, otherwise the blade is interpolated
+	bool bSampleMontage = NumSubSteps > 1 && Montage && Montage == SampledMontage.Get() && MontagePosition > PreviousMontagePosition;
+
+	// Differences between the evaluated animation and the final pose at both frames, blended along the sub-steps
+	// so the samples meet the real blade even with other animation layers on top of the montage
+	FBladeSample StartOffset;
+	FBladeSample EndOffset;
+	if (bSampleMontage)
+	{
+		FBladeSample StartSample;
+		FBladeSample EndSample;
+		bSampleMontage = SampleMontageBlade(Montage, PreviousMontagePosition, StartSample) && SampleMontageBlade(Montage, MontagePosition, EndSample);
+		if (bSampleMontage)
+		{
+			StartOffset.Base = PreviousComponentTransform.InverseTransformPosition(PreviousBlade.Base) - StartSample.Base;
+			StartOffset.Tip = PreviousComponentTransform.InverseTransformPosition(PreviousBlade.Tip) - StartSample.Tip;
+			EndOffset.Base = CurrentComponentTransform.InverseTransformPosition(CurrentBlade.Base) - EndSample.Base;
+			EndOffset.Tip = CurrentComponentTransform.InverseTransformPosition(CurrentBlade.Tip) - EndSample.Tip;
+		}
+	}
+
+	FBladeSample From = PreviousBlade;
+	for (int32 Step = 1; Step <= NumSubSteps && SwingHitActors.Num() < MaxHitsPerSwing; ++Step)
+	{
+		const float Alpha = static_cast<float>(Step) / NumSubSteps;
+
+		FBladeSample To;
+		if (Step == NumSubSteps)
+		{
+			To = CurrentBlade;
+		}
+		else if (bSampleMontage && SampleMontageBlade(Montage, FMath::Lerp(PreviousMontagePosition, MontagePosition, Alpha), To))
+		{
+			FTransform ComponentTransform;
+			ComponentTransform.Blend(PreviousComponentTransform, CurrentComponentTransform, Alpha);
+			To.Base = ComponentTransform.TransformPosition(To.Base + FMath::Lerp(StartOffset.Base, EndOffset.Base, Alpha));
+			To.Tip = ComponentTransform.TransformPosition(To.Tip + FMath::Lerp(StartOffset.Tip, EndOffset.Tip, Alpha));
+		}
+		else
+		{
+			To.Base = FMath::Lerp(PreviousBlade.Base, CurrentBlade.Base, Alpha);
+			To.Tip = FMath::Lerp(PreviousBlade.Tip, CurrentBlade.Tip, Alpha);
+		}
+
+		SweepBlade(From, To);
+		From = To;
+	}
+
+	PreviousBlade = CurrentBlade;
+	PreviousComponentTransform = CurrentComponentTransform;
+	SampledMontage = Montage;
+	PreviousMontagePosition = MontagePosition;
+}
+
+bool UMeleeTraceComponent::BuildBoneChain(FName SocketName, const UAnimSequenceBase* Animation, FSocketBoneChain& OutChain) const
+{
+	const USkeletalMeshComponent* SkeletalMesh = Cast<USkeletalMeshComponent>(TracedMesh);
+	const USkeletalMesh* MeshAsset = SkeletalMesh ? SkeletalMesh->GetSkeletalMeshAsset() : nullptr;
+	const USkeleton* Skeleton = Animation->GetSkeleton();
+	if (!MeshAsset || !Skeleton)
+	{
+		return false;
+	}
+
+	// The name can be a socket or directly a bone
+	FName BoneName = SocketName;
+	OutChain.SocketLocalTransform = FTransform::Identity;
+	if (const USkeletalMeshSocket* Socket = MeshAsset->FindSocket(SocketName))
+	{
+		BoneName = Socket->BoneName;
+		OutChain.SocketLocalTransform = Socket->GetSocketLocalTransform();
+	}
+
+	const FReferenceSkeleton& RefSkeleton = MeshAsset->GetRefSkeleton();
+	int32 MeshBoneIndex = RefSkeleton.FindBoneIndex(BoneName);
+	if (MeshBoneIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutChain.SkeletonBoneIndices.Reset();
+	OutChain.RefPose.Reset();
+	for (; MeshBoneIndex != INDEX_NONE; MeshBoneIndex = RefSkeleton.GetParentIndex(MeshBoneIndex))
+	{
+		OutChain.SkeletonBoneIndices.Add(Skeleton->GetSkeletonBoneIndexFromMeshBoneIndex(MeshAsset, MeshBoneIndex));
+		OutChain.RefPose.Add(RefSkeleton.GetRefBonePose()[MeshBoneIndex]);
+	}
+	return true;
+}
+
+bool UMeleeTraceComponent::SampleMontageBlade(const UAnimMontage* Montage, float MontagePosition, FBladeSample& OutSample)
+{
+	for (const FSlotAnimationTrack& SlotTrack : Montage->SlotAnimTracks)
+	{
+		const FAnimSegment* Segment = SlotTrack.AnimTrack.GetSegmentAtTime(MontagePosition);
+		const UAnimSequence* Sequence = Segment ? Cast<UAnimSequence>(Segment->GetAnimReference()) : nullptr;
+		if (!Sequence)
+		{
+			continue;
+		}
+
+		// The chains only change with the animation
+		if (ChainAnimation.Get() != Sequence)
+		{
+			ChainAnimation = Sequence;
+			bChainsValid = BuildBoneChain(BaseSocketName, Sequence, BaseChain) && BuildBoneChain(TipSocketName, Sequence, TipChain);
+		}
+		if (!bChainsValid)
+		{
+			return false;
+		}
+
+		const double AnimTime = Segment->ConvertTrackPosToAnimPos(MontagePosition);
+		OutSample.Base = MeleeTrace::EvaluateSocketLocation(*Sequence, BaseChain.SkeletonBoneIndices, BaseChain.RefPose, BaseChain.SocketLocalTransform, AnimTime);
+		OutSample.Tip = MeleeTrace::EvaluateSocketLocation(*Sequence, TipChain.SkeletonBoneIndices, TipChain.RefPose, TipChain.SocketLocalTransform, AnimTime);
+		return true;
+	}
+	return false;
+}
+
+void UMeleeTraceComponent::SweepBlade(const FBladeSample& From, const FBladeSample& To)
+{
+	INC_DWORD_STAT(STAT_MeleeSweeps);
+
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(MeleeTrace), false, GetOwner());
+	SweepHits.Reset();
+	const bool bHit = UUtilsLib::SweepCapsuleBetweenSegments(GetWorld(), From.Base, From.Tip, To.Base, To.Tip, TraceRadius, TraceChannel, QueryParams, SweepHits);
+
+	if (GMeleeDebug)
+	{
+		DrawDebugLine(GetWorld(), To.Base, To.Tip, bHit ? FColor::Red : FColor::Green, false, 1.0f);
+	}
+
+	if (!bHit)
+	{
+		return;
+	}
+
+	// The tip moves the fastest, its velocity gives the direction of the impulse
+	const FVector Velocity = (To.Tip - From.Tip).GetSafeNormal() * ImpulseSpeed;
+	for (const FHitResult& Hit : SweepHits)
+	{
+		HandleHit(Hit, Velocity);
+	}
+}
+
+void UMeleeTraceComponent::HandleHit(const FHitResult& Hit, const FVector& Velocity)
+{
+	AActor* HitActor = Hit.GetActor();
+	if (!HitActor || HitActor == GetOwner() || SwingHitActors.Num() >= MaxHitsPerSwing || SwingHitActors.Contains(HitActor))
+	{
+		return;
+	}
+
+	SwingHitActors.Add(HitActor);
+	ARPG_GameProjectile::ApplyHitImpulse(GetOwner(), HitActor, Hit.GetComponent(), Velocity, Hit.ImpactPoint);
+
+	if (UDamagePipelineSubsystem* DamagePipeline = GetWorld()->GetSubsystem<UDamagePipelineSubsystem>())
+	{
+		DamagePipeline->EnqueueDamage({ HitActor, GetOwner(), Damage, EDamageSource::Melee });
+	}
+
+	if (GMeleeDebug)
+	{
+		DrawDebugSphere(GetWorld(), Hit.ImpactPoint, TraceRadius, 12, FColor::Yellow, false, 1.0f);
+	}
+
+	OnMeleeHit.Broadcast(HitActor, Hit);
+}
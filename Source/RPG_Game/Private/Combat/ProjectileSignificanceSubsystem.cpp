@@ -0,0 +1,173 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/ProjectileSignificanceSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "RPG_Game/RPG_GameProjectile.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+#include "FrameArena.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("Projectile Significance Update"), STAT_ProjectileSignificanceUpdate, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles High"), STAT_ProjectilesHigh, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Medium"), STAT_ProjectilesMedium, STATGROUP_RPGCombat);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Projectiles Low"), STAT_ProjectilesLow, STATGROUP_RPGCombat);
+
+static bool GProjectileSignificanceEnabled = true;
+static FAutoConsoleVariableRef CVarProjectileSignificanceEnabled(
+	TEXT("RPG.Projectile.Significance"),
+	GProjectileSignificanceEnabled,
+	TEXT("Lowers the simulation detail of the projectiles far from the players."));
+
+static float GProjectileSignificanceRate = 10.0f;
+static FAutoConsoleVariableRef CVarProjectileSignificanceRate(
+	TEXT("RPG.Projectile.SignificanceRate"),
+	GProjectileSignificanceRate,
+	TEXT("Number of significance updates per second. 0 updates every frame."));
+
+void UProjectileSignificanceSubsystem::Deinitialize()
+{
+	Projectiles.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UProjectileSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UProjectileSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UProjectileSignificanceSubsystem::RegisterProjectile(ARPG_GameProjectile* Projectile)
+{
+	if (!Projectile || Projectile->SignificanceIndex != INDEX_NONE)
+	{
+		return;
+	}
+
+	Projectile->SignificanceIndex = Projectiles.Add(Projectile);
+}
+
+void UProjectileSignificanceSubsystem::UnregisterProjectile(ARPG_GameProjectile* Projectile)
+{
+	if (!Projectile || !Projectiles.IsValidIndex(Projectile->SignificanceIndex) || Projectiles[Projectile->SignificanceIndex] != Projectile)
+	{
+		return;
+	}
+
+	// Swap with the last one to remove in constant time
+	const int32 Index = Projectile->SignificanceIndex;
+	Projectiles.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	if (Projectiles.IsValidIndex(Index))
+	{
+		Projectiles[Index]->SignificanceIndex = Index;
+	}
+	Projectile->SignificanceIndex = INDEX_NONE;
+}
+
+void UProjectileSignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!GProjectileSignificanceEnabled)
+	{
+		if (bHasReducedProjectiles)
+		{
+			RestoreAll();
+		}
+		return;
+	}
+
+	TimeSinceLastUpdate += DeltaTime;
+	if (Projectiles.IsEmpty() || (GProjectileSignificanceRate > 0.0f && TimeSinceLastUpdate < 1.0f / GProjectileSignificanceRate))
+	{
+		return;
+	}
+	TimeSinceLastUpdate = 0.0f;
+
+	UpdateSignificance();
+}
+
+void UProjectileSignificanceSubsystem::UpdateSignificance()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ProjectileSignificanceUpdate);
+	GENLIB_PERF_SCOPE("ProjectileSignificance");
+
+	// Only local players exist on clients, the server sees the view point of every player
+	TArray<FTransform, TInlineAllocator<8, FFrameArenaAllocator>> Viewers;
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		if (const APlayerController* PlayerController = Iterator->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			Viewers.Emplace(ViewRotation, ViewLocation);
+		}
+	}
+
+	SignificanceCounts = TStaticArray<int32, 3>(InPlace, 0);
+	for (ARPG_GameProjectile* Projectile : Projectiles)
+	{
+		const EProjectileSignificance Significance = ComputeSignificance(Projectile->GetActorLocation(), Viewers);
+		if (Significance != Projectile->GetSignificance())
+		{
+			Projectile->SetSignificance(Significance, GetTickInterval(Significance));
+		}
+		++SignificanceCounts[static_cast<int32>(Significance)];
+	}
+
+	bHasReducedProjectiles = SignificanceCounts[static_cast<int32>(EProjectileSignificance::High)] != Projectiles.Num();
+
+	SET_DWORD_STAT(STAT_ProjectilesHigh, SignificanceCounts[static_cast<int32>(EProjectileSignificance::High)]);
+	SET_DWORD_STAT(STAT_ProjectilesMedium, SignificanceCounts[static_cast<int32>(EProjectileSignificance::Medium)]);
+	SET_DWORD_STAT(STAT_ProjectilesLow, SignificanceCounts[static_cast<int32>(EProjectileSignificance::Low)]);
+}
+
+EProjectileSignificance UProjectileSignificanceSubsystem::ComputeSignificance(const FVector& Location, TConstArrayView<FTransform> Viewers) const
+{
+	// Nobody looks at the projectiles when there are no players
+	double MinDistSquared = TNumericLimits<double>::Max();
+	const double BehindScaleSquared = FMath::Square(BehindViewerDistanceScale);
+	for (const FTransform& Viewer : Viewers)
+	{
+		const FVector ToProjectile = Location - Viewer.GetLocation();
+		double DistSquared = ToProjectile.SizeSquared();
+		if ((ToProjectile | Viewer.GetUnitAxis(EAxis::X)) < 0.0)
+		{
+			DistSquared *= BehindScaleSquared;
+		}
+		MinDistSquared = FMath::Min(MinDistSquared, DistSquared);
+	}
+
+	if (MinDistSquared < FMath::Square(MediumDistance))
+	{
+		return EProjectileSignificance::High;
+	}
+	return MinDistSquared < FMath::Square(LowDistance) ? EProjectileSignificance::Medium : EProjectileSignificance::Low;
+}
+
+float UProjectileSignificanceSubsystem::GetTickInterval(EProjectileSignificance Significance) const
+{
+	switch (Significance)
+	{
+	case EProjectileSignificance::Medium:
+		return MediumTickInterval;
+	case EProjectileSignificance::Low:
+		return LowTickInterval;
+	default:
+		return 0.0f;
+	}
+}
+
+void UProjectileSignificanceSubsystem::RestoreAll()
+{
+	for (ARPG_GameProjectile* Projectile : Projectiles)
+	{
+		Projectile->SetSignificance(EProjectileSignificance::High, 0.0f);
+	}
+
+	SignificanceCounts = TStaticArray<int32, 3>(InPlace, 0);
+	SignificanceCounts[static_cast<int32>(EProjectileSignificance::High)] = Projectiles.Num();
+	bHasReducedProjectiles = false;
+}
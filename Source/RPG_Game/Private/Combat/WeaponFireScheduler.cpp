@@ -0,0 +1,56 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Combat/WeaponFireScheduler.h"
+
+void FWeaponFireScheduler::Configure(float RoundsPerMinute, bool bInAutomatic)
+{
+	ShotInterval = 60.0f / FMath::Max(RoundsPerMinute, 1.0f);
+	bAutomatic = bInAutomatic;
+}
+
+void FWeaponFireScheduler::StartFiring()
+{
+	bTriggerHeld = true;
+}
+
+void FWeaponFireScheduler::StopFiring()
+{
+	bTriggerHeld = false;
+}
+
+/**
+ * The time left until the next shot is carried between frames, so the exact amount of shots is fired
+ * whatever the frame rate. Shots are placed at their exact time inside the frame. While the trigger
+ * is released the weapon keeps cooling down, so tapping the trigger can't exceed the rate of fire.
+ */
+int32 FWeaponFireScheduler::Advance(float DeltaTime, TArray<float, TInlineAllocator<8>>& OutShotAlphas)
+{
+	OutShotAlphas.Reset();
+
+	if (DeltaTime <= 0.0f)
+	{
+		return 0;
+	}
+
+	if (!bTriggerHeld)
+	{
+		TimeUntilNextShot = FMath::Max(TimeUntilNextShot - DeltaTime, 0.0f);
+		return 0;
+	}
+
+	float ShotTime = TimeUntilNextShot;
+	while (bTriggerHeld && ShotTime <= DeltaTime && OutShotAlphas.Num() < MaxShotsPerFrame)
+	{
+		OutShotAlphas.Add(ShotTime / DeltaTime);
+		ShotTime += ShotInterval;
+
+		// Semi automatic weapons need the trigger to be pulled again
+		if (!bAutomatic)
+		{
+			bTriggerHeld = false;
+		}
+	}
+
+	TimeUntilNextShot = FMath::Max(ShotTime - DeltaTime, 0.0f);
+	return OutShotAlphas.Num();
+}
@@ -0,0 +1,8 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Core/RPGGameplayTags.h"
+
+namespace RPGGameplayTags
+{
+	UE_DEFINE_GAMEPLAY_TAG(SetByCaller_Damage, "SetByCaller.Damage");
+}
@@ -0,0 +1,410 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Inventory/EquipmentComponent.h"
+#include "Inventory/InventoryComponent.h"
+#include "Inventory/EquipmentStreamingSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMesh.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Net/UnrealNetwork.h"
+#include "SkeletalMeshMerge.h"
+
+DECLARE_CYCLE_STAT(TEXT("Equipment Apply Meshes"), STAT_EquipmentApplyMeshes, STATGROUP_RPGItems);
+DECLARE_CYCLE_STAT(TEXT("Equipment Mesh Merge"), STAT_EquipmentMeshMerge, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Equipment Merged Meshes"), STAT_EquipmentMergedMeshes, STATGROUP_RPGItems);
+
+namespace EquipmentMeshCache
+{
+	// Source meshes of a merge, the body first then the armor pieces in slot order
+	struct FSourcesKey
+	{
+		TArray<TObjectKey<USkeletalMesh>, TInlineAllocator<8>> Sources;
+
+		FSourcesKey(USkeletalMesh* BaseMesh, const TArray<USkeletalMesh*>& ArmorMeshes)
+		{
+			Sources.Reserve(ArmorMeshes.Num() + 1);
+			Sources.Add(BaseMesh);
+			for (USkeletalMesh* Mesh : ArmorMeshes)
+			{
+				Sources.Add(Mesh);
+			}
+		}
+
+		bool operator==(const FSourcesKey& Other) const { return Sources == Other.Sources; }
+
+		friend uint32 GetTypeHash(const FSourcesKey& Key)
+		{
+			uint32 Hash = 0;
+			for (const TObjectKey<USkeletalMesh>& Source : Key.Sources)
+			{
+				Hash = HashCombineFast(Hash, GetTypeHash(Source));
+			}
+			return Hash;
+		}
+	};
+
+	// Merged meshes by their source meshes, alive while a character uses them
+	static TMap<FSourcesKey, TWeakObjectPtr<USkeletalMesh>> MergedMeshes;
+
+	// Removes the merged meshes no character uses anymore
+	static void PruneStale()
+	{
+		for (auto It = MergedMeshes.CreateIterator(); It; ++It)
+		{
+			if (!It.Value().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+}
+
+static constexpr int32 NumEquipmentSlots = static_cast<int32>(EEquipmentSlot::Num);
+
+// Sets default values for this component's properties
+UEquipmentComponent::UEquipmentComponent()
+	: ItemDataTable(nullptr)
+{
+	// Only ticks the frame after a change, to apply all the changes of a frame together
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+
+	SetIsReplicatedByDefault(true);
+
+	EquippedItems.SetNum(NumEquipmentSlots);
+	PieceComponents.SetNum(NumEquipmentSlots);
+}
+
+void UEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UEquipmentComponent, EquippedItems);
+}
+
+// Called when the game starts
+void UEquipmentComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!BodyMesh)
+	{
+		SetBodyMeshComponent(GetOwner()->FindComponentByClass<USkeletalMeshComponent>());
+	}
+
+	RequestVisualsUpdate();
+}
+
+void UEquipmentComponent::SetBodyMeshComponent(USkeletalMeshComponent* InBodyMesh)
+{
+	BodyMesh = InBodyMesh;
+	if (BodyMesh && !BaseMesh)
+	{
+		BaseMesh = BodyMesh->GetSkeletalMeshAsset();
+	}
+}
+
+bool UEquipmentComponent::EquipItem(FName ItemId)
+{
+	if (!CheckAuthority())
+	{
+		return false;
+	}
+
+	const FItemStruct* ItemData = FindItemData(ItemId);
+	if (!ItemData || ItemData->EquipmentSlot == EEquipmentSlot::None || ItemData->EquipmentSlot == EEquipmentSlot::Num)
+	{
+		UE_LOG(InventoryLog, Warning, TEXT("Item %s can't be equipped. %s"), *ItemId.ToString(), *RPG_LOGS_LINE);
+		return false;
+	}
+
+	// The equipped items come from the inventory when the owner has one
+	if (const UInventoryComponent* Inventory = GetOwner()->FindComponentByClass<UInventoryComponent>())
+	{
+		if (Inventory->GetItemCount(ItemId) <= 0)
+		{
+			UE_LOG(InventoryLog, Warning, TEXT("Item %s is not in the inventory of %s. %s"), *ItemId.ToString(), *GetNameSafe(GetOwner()), *RPG_LOGS_LINE);
+			return false;
+		}
+	}
+
+	FName& SlotItem = EquippedItems[static_cast<int32>(ItemData->EquipmentSlot)];
+	if (SlotItem == ItemId)
+	{
+		return true;
+	}
+
+	SlotItem = ItemId;
+	RequestVisualsUpdate();
+	return true;
+}
+
+FName UEquipmentComponent::UnequipSlot(EEquipmentSlot Slot)
+{
+	if (!CheckAuthority() || Slot == EEquipmentSlot::None || Slot == EEquipmentSlot::Num)
+	{
+		return NAME_None;
+	}
+
+	const FName Removed = EquippedItems[static_cast<int32>(Slot)];
+	if (!Removed.IsNone())
+	{
+		EquippedItems[static_cast<int32>(Slot)] = NAME_None;
+		RequestVisualsUpdate();
+	}
+	return Removed;
+}
+
+FName UEquipmentComponent::GetEquippedItem(EEquipmentSlot Slot) const
+{
+	return EquippedItems.IsValidIndex(static_cast<int32>(Slot)) ? EquippedItems[static_cast<int32>(Slot)] : NAME_None;
+}
+
+int32 UEquipmentComponent::GetNumSkinnedComponents() const
+{
+	int32 NumComponents = BodyMesh && BodyMesh->GetSkeletalMeshAsset() ? 1 : 0;
+	for (const USkeletalMeshComponent* Component : PieceComponents)
+	{
+		if (Component && Component->GetSkeletalMeshAsset())
+		{
+			++NumComponents;
+		}
+	}
+	return NumComponents;
+}
+
+void UEquipmentComponent::OnRep_EquippedItems()
+{
+	RequestVisualsUpdate();
+}
+
+void UEquipmentComponent::RequestVisualsUpdate()
+{
+	// Nothing is rendered on a dedicated server
+	if (GetNetMode() == NM_DedicatedServer || !BodyMesh)
+	{
+		return;
+	}
+
+	SetComponentTickEnabled(true);
+}
+
+void UEquipmentComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	SetComponentTickEnabled(false);
+	LoadEquippedMeshes();
+}
+
+void UEquipmentComponent::LoadEquippedMeshes()
+{
+	TArray<FSoftObjectPath> MeshPaths;
+	for (const FName ItemId : EquippedItems)
+	{
+		if (const FItemStruct* ItemData = ItemId.IsNone() ? nullptr : FindItemData(ItemId))
+		{
+			if (!ItemData->EquippedMesh.IsNull())
+			{
+				MeshPaths.Add(ItemData->EquippedMesh.ToSoftObjectPath());
+			}
+		}
+	}
+
+	const uint32 Serial = ++LoadSerial;
+	if (MeshPaths.IsEmpty())
+	{
+		LoadHandle.Reset();
+		ApplyEquippedMeshes();
+		return;
+	}
+
+	// A newer change replaces this request, only the last one is applied
+	LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(MeshPaths), FStreamableDelegate::CreateWeakLambda(this, [this, Serial]()
+	{
+		UEquipmentStreamingSubsystem* Streaming = GetWorld() ? GetWorld()->GetSubsystem<UEquipmentStreamingSubsystem>() : nullptr;
+		if (!Streaming || !Streaming->QueueLoadedMeshes(this, Serial))
+		{
+			ApplyLoadedMeshes(Serial);
+		}
+	}));
+}
+
+void UEquipmentComponent::ApplyLoadedMeshes(uint32 Serial)
+{
+	if (Serial == LoadSerial)
+	{
+		ApplyEquippedMeshes();
+	}
+}
+
+void UEquipmentComponent::ApplyEquippedMeshes()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EquipmentApplyMeshes);
+
+	if (!BodyMesh)
+	{
+		return;
+	}
+
+	TArray<USkeletalMesh*> ArmorMeshes;
+	if (bMergeArmorMeshes)
+	{
+		GetArmorMeshes(ArmorMeshes);
+	}
+
+	// The merge is built in a later frame, the armor pieces are separate components until it is ready
+	USkeletalMesh* MergedMesh = ArmorMeshes.IsEmpty() ? nullptr : FindMergedMesh(ArmorMeshes);
+	if (!ArmorMeshes.IsEmpty() && !MergedMesh && FailedMergeSerial != LoadSerial)
+	{
+		UEquipmentStreamingSubsystem* Streaming = GetWorld() ? GetWorld()->GetSubsystem<UEquipmentStreamingSubsystem>() : nullptr;
+		if (!Streaming || !Streaming->QueueMerge(this, LoadSerial))
+		{
+			MergedMesh = MergeMeshes(ArmorMeshes);
+			if (!MergedMesh)
+			{
+				FailedMergeSerial = LoadSerial;
+			}
+		}
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < NumEquipmentSlots; ++SlotIndex)
+	{
+		const EEquipmentSlot Slot = static_cast<EEquipmentSlot>(SlotIndex);
+		const FItemStruct* ItemData = EquippedItems[SlotIndex].IsNone() ? nullptr : FindItemData(EquippedItems[SlotIndex]);
+		USkeletalMesh* Mesh = ItemData ? ItemData->EquippedMesh.Get() : nullptr;
+
+		// Weapons, and armor pieces when they are not merged, use their own component
+		const bool bWeapon = IsWeaponSlot(Slot);
+		if (Mesh && (bWeapon || !MergedMesh))
+		{
+			const FName Socket = Slot == EEquipmentSlot::MainHand ? MainHandSocket : Slot == EEquipmentSlot::OffHand ? OffHandSocket : NAME_None;
+			USkeletalMeshComponent* Component = EnsurePieceComponent(PieceComponents[SlotIndex], Socket);
+			Component->SetSkeletalMesh(Mesh, false);
+			Component->SetLeaderPoseComponent(bWeapon ? nullptr : BodyMesh.Get());
+		}
+		else if (PieceComponents[SlotIndex])
+		{
+			PieceComponents[SlotIndex]->DestroyComponent();
+			PieceComponents[SlotIndex] = nullptr;
+		}
+	}
+
+	USkeletalMesh* BodyAsset = MergedMesh ? MergedMesh : BaseMesh.Get();
+	if (BodyMesh->GetSkeletalMeshAsset() != BodyAsset)
+	{
+		BodyMesh->SetSkeletalMesh(BodyAsset, false);
+	}
+
+	OnEquipmentChanged.Broadcast();
+}
+
+void UEquipmentComponent::MergeLoadedMeshes(uint32 Serial)
+{
+	// A newer change was applied since, it queued its own merge
+	if (Serial != LoadSerial || !BodyMesh)
+	{
+		return;
+	}
+
+	TArray<USkeletalMesh*> ArmorMeshes;
+	GetArmorMeshes(ArmorMeshes);
+	if (!ArmorMeshes.IsEmpty() && !FindMergedMesh(ArmorMeshes) && !MergeMeshes(ArmorMeshes))
+	{
+		// The pieces stay separate for this equipment instead of retrying every frame
+		FailedMergeSerial = Serial;
+	}
+
+	ApplyEquippedMeshes();
+}
+
+void UEquipmentComponent::GetArmorMeshes(TArray<USkeletalMesh*>& OutArmorMeshes) const
+{
+	for (int32 SlotIndex = 0; SlotIndex < NumEquipmentSlots; ++SlotIndex)
+	{
+		const FItemStruct* ItemData = EquippedItems[SlotIndex].IsNone() || IsWeaponSlot(static_cast<EEquipmentSlot>(SlotIndex)) ? nullptr : FindItemData(EquippedItems[SlotIndex]);
+		if (USkeletalMesh* Mesh = ItemData ? ItemData->EquippedMesh.Get() : nullptr)
+		{
+			OutArmorMeshes.Add(Mesh);
+		}
+	}
+}
+
+USkeletalMesh* UEquipmentComponent::FindMergedMesh(const TArray<USkeletalMesh*>& ArmorMeshes) const
+{
+	return BaseMesh ? EquipmentMeshCache::MergedMeshes.FindRef(EquipmentMeshCache::FSourcesKey(BaseMesh, ArmorMeshes)).Get() : nullptr;
+}
+
+USkeletalMesh* UEquipmentComponent::MergeMeshes(const TArray<USkeletalMesh*>& ArmorMeshes) const
+{
+	if (!BaseMesh)
+	{
+		return nullptr;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_EquipmentMeshMerge);
+
+	TArray<USkeletalMesh*> Sources;
+	Sources.Reserve(ArmorMeshes.Num() + 1);
+	Sources.Add(BaseMesh);
+	Sources.Append(ArmorMeshes);
+
+	USkeletalMesh* MergedMesh = NewObject<USkeletalMesh>(GetTransientPackage(), NAME_None, RF_Transient);
+	MergedMesh->SetSkeleton(BaseMesh->GetSkeleton());
+
+	FSkeletalMeshMerge Merger(MergedMesh, Sources, TArray<FSkelMeshMergeSectionMapping>(), 0);
+	if (!Merger.DoMerge())
+	{
+		UE_LOG(InventoryLog, Error, TEXT("The equipment of %s could not be merged, check the CPU access of the meshes. %s"), *GetNameSafe(GetOwner()), *RPG_LOGS_LINE);
+		return nullptr;
+	}
+
+	// The merge only builds the render data, the body keeps its collision and ragdoll
+	MergedMesh->SetPhysicsAsset(BaseMesh->GetPhysicsAsset());
+
+	EquipmentMeshCache::PruneStale();
+	EquipmentMeshCache::MergedMeshes.Add(EquipmentMeshCache::FSourcesKey(BaseMesh, ArmorMeshes), MergedMesh);
+	INC_DWORD_STAT(STAT_EquipmentMergedMeshes);
+	return MergedMesh;
+}
+
+USkeletalMeshComponent* UEquipmentComponent::EnsurePieceComponent(TObjectPtr<USkeletalMeshComponent>& Component, FName Socket) const
+{
+	if (!Component)
+	{
+		Component = NewObject<USkeletalMeshComponent>(GetOwner());
+		Component->SetupAttachment(BodyMesh, Socket);
+		Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Component->RegisterComponent();
+	}
+	return Component;
+}
+
+const FItemStruct* UEquipmentComponent::FindItemData(FName ItemId) const
+{
+	if (!ItemDataTable)
+	{
+		UE_LOG(InventoryLog, Warning, TEXT("ItemDataTable is not assigned in the equipment of %s"), *GetNameSafe(GetOwner()));
+		return nullptr;
+	}
+
+	const FItemStruct* ItemData = ItemDataTable->FindRow<FItemStruct>(ItemId, TEXT("UEquipmentComponent::FindItemData"), false);
+	if (!ItemData)
+	{
+		UE_LOG(InventoryLog, Error, TEXT("Row %s not found in the assigned DataTable."), *ItemId.ToString());
+	}
+	return ItemData;
+}
+
+bool UEquipmentComponent::CheckAuthority() const
+{
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		return true;
+	}
+
+	UE_LOG(InventoryLog, Warning, TEXT("Equipment operations are only allowed with authority. %s"), *RPG_LOGS_LINE);
+	return false;
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Inventory/EquipmentStreamingSubsystem.h"
+#include "Inventory/EquipmentComponent.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static float GEquipmentApplyBudgetMs = 2.0f;
+static FAutoConsoleVariableRef CVarEquipmentApplyBudgetMs(
+	TEXT("RPG.Equipment.ApplyBudgetMs"),
+	GEquipmentApplyBudgetMs,
+	TEXT("Time spent applying the loaded equipment meshes per frame, in milliseconds. 0 applies them all."));
+
+static float GEquipmentMergeBudgetMs = 1.0f;
+static FAutoConsoleVariableRef CVarEquipmentMergeBudgetMs(
+	TEXT("RPG.Equipment.MergeBudgetMs"),
+	GEquipmentMergeBudgetMs,
+	TEXT("Time spent merging the armor pieces of the equipments per frame, in milliseconds. At least one merge is done per frame, 0 merges them all."));
+
+// Loaded equipments waiting at most, more are applied as soon as they load
+static constexpr uint32 MaxPendingLoads = 1024;
+
+void UEquipmentStreamingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Nothing is rendered on a dedicated server
+	if (InWorld.GetNetMode() == NM_DedicatedServer)
+	{
+		return;
+	}
+
+	LoadedMeshes = MakeUnique<TGameThreadResultSink<FEquipmentLoadResult>>(MaxPendingLoads, [](FEquipmentLoadResult&& Result)
+	{
+		if (UEquipmentComponent* Equipment = Result.Equipment.Get())
+		{
+			Equipment->ApplyLoadedMeshes(Result.Serial);
+		}
+	});
+	// A merge can take milliseconds, so the budget is checked after every equipment
+	LoadedMeshes->Register(&InWorld, TG_PostUpdateWork, GEquipmentApplyBudgetMs / 1000.0, 1);
+
+	PendingMerges = MakeUnique<TGameThreadResultSink<FEquipmentLoadResult>>(MaxPendingLoads, [](FEquipmentLoadResult&& Result)
+	{
+		if (UEquipmentComponent* Equipment = Result.Equipment.Get())
+		{
+			Equipment->MergeLoadedMeshes(Result.Serial);
+		}
+	});
+	PendingMerges->Register(&InWorld, TG_PostUpdateWork, GEquipmentMergeBudgetMs / 1000.0, 1);
+}
+
+void UEquipmentStreamingSubsystem::Deinitialize()
+{
+	LoadedMeshes.Reset();
+	PendingMerges.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UEquipmentStreamingSubsystem::QueueLoadedMeshes(UEquipmentComponent* Equipment, uint32 Serial)
+{
+	if (!LoadedMeshes || !LoadedMeshes->IsRegistered())
+	{
+		return false;
+	}
+
+	LoadedMeshes->SetBudget(GEquipmentApplyBudgetMs / 1000.0);
+	return LoadedMeshes->Push(FEquipmentLoadResult{ Equipment, Serial });
+}
+
+bool UEquipmentStreamingSubsystem::QueueMerge(UEquipmentComponent* Equipment, uint32 Serial)
+{
+	if (!PendingMerges || !PendingMerges->IsRegistered())
+	{
+		return false;
+	}
+
+	PendingMerges->SetBudget(GEquipmentMergeBudgetMs / 1000.0);
+	return PendingMerges->Push(FEquipmentLoadResult{ Equipment, Serial });
+}
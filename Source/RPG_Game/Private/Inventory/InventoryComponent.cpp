@@ -0,0 +1,410 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Inventory/InventoryComponent.h"
+#include "Items/BaseItem.h"
+#include "Items/ItemPoolSubsystem.h"
+#include "Persistence/WorldStateSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "Net/UnrealNetwork.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/UObjectIterator.h"
+
+DECLARE_CYCLE_STAT(TEXT("Inventory Operation"), STAT_InventoryOperation, STATGROUP_RPGItems);
+
+void FInventoryEntry::PostReplicatedAdd(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->NotifyInventoryChanged();
+	}
+}
+
+void FInventoryEntry::PostReplicatedChange(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->NotifyInventoryChanged();
+	}
+}
+
+void FInventoryEntry::PreReplicatedRemove(const FInventoryList& InArraySerializer)
+{
+	if (InArraySerializer.OwnerComponent)
+	{
+		InArraySerializer.OwnerComponent->NotifyInventoryChanged();
+	}
+}
+
+// Sets default values for this component's properties
+UInventoryComponent::UInventoryComponent()
+	: ItemDataTable(nullptr)
+{
+	DroppedItemClass = ABaseItem::StaticClass();
+
+	PrimaryComponentTick.bCanEverTick = false;
+
+	SetIsReplicatedByDefault(true);
+
+	Inventory.OwnerComponent = this;
+}
+
+void UInventoryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UInventoryComponent, Inventory);
+}
+
+// Called when the game starts
+void UInventoryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Allocate the whole inventory once, so the operations never grow the array
+	Inventory.Entries.Reserve(MaxEntries);
+}
+
+/**
+ * Adds items to the inventory. The existing entries of the same item and durability are filled first,
+ * the remaining items are stored in new entries while there is space in the inventory.
+ */
+int32 UInventoryComponent::AddItem(FName ItemId, int32 Count, int32 Durability)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InventoryOperation);
+
+	if (!CheckAuthority() || Count <= 0)
+	{
+		return Count;
+	}
+
+	const FItemStruct* ItemData = FindItemData(ItemId);
+	if (!ItemData)
+	{
+		return Count;
+	}
+
+	const int32 MaxStackSize = FMath::Clamp(ItemData->MaxStackSize, 1, static_cast<int32>(MAX_int16));
+	const uint16 EntryDurability = static_cast<uint16>(FMath::Clamp(Durability < 0 ? ItemData->MaxDurability : Durability, 0, static_cast<int32>(MAX_uint16)));
+
+	int32 Remaining = Count;
+
+	// Fill the existing stacks
+	for (FInventoryEntry& Entry : Inventory.Entries)
+	{
+		if (Remaining == 0)
+		{
+			break;
+		}
+		if (Entry.ItemId == ItemId && Entry.Durability == EntryDurability && Entry.StackCount < MaxStackSize)
+		{
+			const int32 Added = FMath::Min(Remaining, MaxStackSize - Entry.StackCount);
+			Entry.StackCount += static_cast<int16>(Added);
+			Remaining -= Added;
+			Inventory.MarkItemDirty(Entry);
+		}
+	}
+
+	// Create new stacks with the rest
+	while (Remaining > 0 && Inventory.Entries.Num() < MaxEntries)
+	{
+		const int32 Added = FMath::Min(Remaining, MaxStackSize);
+		FInventoryEntry& Entry = Inventory.Entries.Emplace_GetRef(ItemId, static_cast<int16>(Added), EntryDurability);
+		Remaining -= Added;
+		Inventory.MarkItemDirty(Entry);
+	}
+
+	if (Remaining != Count)
+	{
+		NotifyInventoryChanged();
+	}
+	return Remaining;
+}
+
+/**
+ * Removes items from the inventory. The last entries of the item are emptied first,
+ * and the entries that end up empty are removed from the inventory.
+ */
+int32 UInventoryComponent::RemoveItem(FName ItemId, int32 Count)
+{
+	SCOPE_CYCLE_COUNTER(STAT_InventoryOperation);
+
+	if (!CheckAuthority() || Count <= 0)
+	{
+		return 0;
+	}
+
+	int32 Removed = 0;
+	bool bRemovedEntries = false;
+	for (int32 Index = Inventory.Entries.Num() - 1; Index >= 0 && Removed < Count; --Index)
+	{
+		FInventoryEntry& Entry = Inventory.Entries[Index];
+		if (Entry.ItemId != ItemId)
+		{
+			continue;
+		}
+
+		const int32 Taken = FMath::Min(Count - Removed, static_cast<int32>(Entry.StackCount));
+		Entry.StackCount -= static_cast<int16>(Taken);
+		Removed += Taken;
+
+		if (Entry.StackCount <= 0)
+		{
+			// The order of the entries is not relevant, so the array is kept packed without shifting
+			Inventory.Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			bRemovedEntries = true;
+		}
+		else
+		{
+			Inventory.MarkItemDirty(Entry);
+		}
+	}
+
+	if (bRemovedEntries)
+	{
+		Inventory.MarkArrayDirty();
+	}
+	if (Removed > 0)
+	{
+		NotifyInventoryChanged();
+	}
+	return Removed;
+}
+
+/**
+ * Stores the item represented by the actor in the inventory and returns the actor to the item pool.
+ * The actor is left in the world if the item doesn't fit in the inventory.
+ */
+bool UInventoryComponent::PickUpItem(ABaseItem* Item)
+{
+	if (!Item || !CheckAuthority())
+	{
+		return false;
+	}
+
+	if (Item->GetItemDataTable() != ItemDataTable)
+	{
+		UE_LOG(InventoryLog, Warning, TEXT("Item %s uses a different DataTable than the inventory of %s. %s"), *Item->GetName(), *GetNameSafe(GetOwner()), *RPG_LOGS_LINE);
+		return false;
+	}
+
+	if (AddItem(Item->GetRowName(), 1, -1) > 0)
+	{
+		return false;
+	}
+
+	// Items placed in the level stay removed when the level is loaded again
+	if (UWorldStateSubsystem* WorldState = GetWorld()->GetSubsystem<UWorldStateSubsystem>())
+	{
+		WorldState->MarkPickedUp(Item);
+	}
+
+	if (UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>())
+	{
+		ItemPool->ReleaseItem(Item);
+	}
+	else
+	{
+		Item->Destroy();
+	}
+	return true;
+}
+
+ABaseItem* UInventoryComponent::DropItem(FName ItemId, const FTransform& Transform)
+{
+	if (RemoveItem(ItemId, 1) == 0)
+	{
+		return nullptr;
+	}
+
+	UItemPoolSubsystem* ItemPool = GetWorld()->GetSubsystem<UItemPoolSubsystem>();
+	return ItemPool ? ItemPool->AcquireItem(DroppedItemClass, ItemDataTable, ItemId, Transform) : nullptr;
+}
+
+int32 UInventoryComponent::GetItemCount(FName ItemId) const
+{
+	int32 Total = 0;
+	for (const FInventoryEntry& Entry : Inventory.Entries)
+	{
+		if (Entry.ItemId == ItemId)
+		{
+			Total += Entry.StackCount;
+		}
+	}
+	return Total;
+}
+
+void UInventoryComponent::NotifyInventoryChanged()
+{
+	OnInventoryChanged.Broadcast();
+}
+
+const FItemStruct* UInventoryComponent::FindItemData(FName ItemId) const
+{
+	if (!ItemDataTable)
+	{
+		UE_LOG(InventoryLog, Warning, TEXT("ItemDataTable is not assigned in the inventory of %s"), *GetNameSafe(GetOwner()));
+		return nullptr;
+	}
+
+	const FItemStruct* ItemData = ItemDataTable->FindRow<FItemStruct>(ItemId, TEXT("UInventoryComponent::FindItemData"), false);
+	if (!ItemData)
+	{
+		UE_LOG(InventoryLog, Error, TEXT("Row %s not found in the assigned DataTable."), *ItemId.ToString());
+	}
+	return ItemData;
+}
+
+bool UInventoryComponent::CheckAuthority() const
+{
+	if (GetOwner() && GetOwner()->HasAuthority())
+	{
+		return true;
+	}
+
+	UE_LOG(InventoryLog, Warning, TEXT("Inventory operations are only allowed with authority. %s"), *RPG_LOGS_LINE);
+	return false;
+}
+
+
+/**
+ * Stress test of the inventory operations, meant to be run on a dedicated server.
+ * Usage: RPG.Inventory.Stress [OpsPerSecond=10000] [Seconds=10]
+ * Performs random add and remove operations on every inventory of the world at the requested rate,
+ * then logs the CPU time spent in the operations and the bytes sent by the net driver during the test.
+ */
+namespace InventoryStress
+{
+	struct FStressState
+	{
+		TWeakObjectPtr<UWorld> World;
+		TArray<TWeakObjectPtr<UInventoryComponent>> Inventories;
+		TArray<FName> ItemIds;
+		FTSTicker::FDelegateHandle TickerHandle;
+		FRandomStream Random;
+		double OpsPerSecond = 10000.0;
+		double Duration = 10.0;
+		double Elapsed = 0.0;
+		double PendingOps = 0.0;
+		int64 TotalOps = 0;
+		uint64 TotalCycles = 0;
+		uint64 StartOutBytes = 0;
+	};
+
+	static FStressState State;
+
+	static uint64 GetOutBytes(const UWorld* World)
+	{
+		const UNetDriver* NetDriver = World ? World->GetNetDriver() : nullptr;
+		return NetDriver ? NetDriver->OutTotalBytes : 0;
+	}
+
+	static void Finish()
+	{
+		const double CpuMs = FPlatformTime::ToMilliseconds64(State.TotalCycles);
+		const uint64 Bytes = GetOutBytes(State.World.Get()) - State.StartOutBytes;
+		UE_LOG(InventoryLog, Display, TEXT("Inventory stress finished: %lld ops in %.2f s, CPU %.3f ms (%.1f ns/op), %llu bytes sent (%.2f bytes/op)"),
+			State.TotalOps, State.Elapsed, CpuMs,
+			State.TotalOps > 0 ? CpuMs * 1000000.0 / State.TotalOps : 0.0,
+			Bytes, State.TotalOps > 0 ? static_cast<double>(Bytes) / State.TotalOps : 0.0);
+
+		State.TickerHandle.Reset();
+		State.Inventories.Reset();
+	}
+
+	static bool Tick(float DeltaTime)
+	{
+		if (!State.World.IsValid() || State.Inventories.IsEmpty())
+		{
+			Finish();
+			return false;
+		}
+
+		State.Elapsed += DeltaTime;
+		State.PendingOps += State.OpsPerSecond * DeltaTime;
+
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+		while (State.PendingOps >= 1.0)
+		{
+			State.PendingOps -= 1.0;
+
+			UInventoryComponent* Inventory = State.Inventories[State.Random.RandHelper(State.Inventories.Num())].Get();
+			if (!Inventory)
+			{
+				continue;
+			}
+
+			const FName ItemId = State.ItemIds[State.Random.RandHelper(State.ItemIds.Num())];
+			if (State.Random.FRand() < 0.5f)
+			{
+				Inventory->AddItem(ItemId, 1 + State.Random.RandHelper(4), -1);
+			}
+			else
+			{
+				Inventory->RemoveItem(ItemId, 1 + State.Random.RandHelper(4));
+			}
+			++State.TotalOps;
+		}
+		State.TotalCycles += FPlatformTime::Cycles64() - StartCycles;
+
+		if (State.Elapsed >= State.Duration)
+		{
+			Finish();
+			return false;
+		}
+		return true;
+	}
+
+	static void Start(const TArray<FString>& Args, UWorld* World)
+	{
+		if (State.TickerHandle.IsValid())
+		{
+			UE_LOG(InventoryLog, Warning, TEXT("Inventory stress is already running."));
+			return;
+		}
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(InventoryLog, Error, TEXT("Inventory stress must run with authority. %s"), *RPG_LOGS_LINE);
+			return;
+		}
+		if (World->GetNetMode() != NM_DedicatedServer)
+		{
+			UE_LOG(InventoryLog, Warning, TEXT("Inventory stress is not running on a dedicated server, results include the local client cost."));
+		}
+
+		State = FStressState();
+		State.World = World;
+		State.Random.Initialize(0x1A2B3C4D);
+		State.OpsPerSecond = Args.Num() > 0 ? FMath::Max(1.0, FCString::Atod(*Args[0])) : 10000.0;
+		State.Duration = Args.Num() > 1 ? FMath::Max(0.1, FCString::Atod(*Args[1])) : 10.0;
+
+		for (TObjectIterator<UInventoryComponent> It; It; ++It)
+		{
+			if (It->GetWorld() == World && It->ItemDataTable)
+			{
+				State.Inventories.Add(*It);
+				if (State.ItemIds.IsEmpty())
+				{
+					State.ItemIds = It->ItemDataTable->GetRowNames();
+				}
+			}
+		}
+
+		if (State.Inventories.IsEmpty() || State.ItemIds.IsEmpty())
+		{
+			UE_LOG(InventoryLog, Error, TEXT("Inventory stress needs at least one inventory with an ItemDataTable in the world."));
+			return;
+		}
+
+		State.StartOutBytes = GetOutBytes(World);
+		State.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&Tick));
+		UE_LOG(InventoryLog, Display, TEXT("Inventory stress started: %.0f ops/s for %.1f s on %d inventories."), State.OpsPerSecond, State.Duration, State.Inventories.Num());
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs InventoryStressCommand(
+	TEXT("RPG.Inventory.Stress"),
+	TEXT("Runs random inventory operations on the server. Usage: RPG.Inventory.Stress [OpsPerSecond=10000] [Seconds=10]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&InventoryStress::Start));
@@ -2,12 +2,118 @@
 
 #include "Items/BaseItem.h"
 #include "RPG_Game/RPG_Game.h"
+#include "GameplayPerfTracker.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Initializations Performed"), STAT_ItemInitializationsPerformed, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Initializations Skipped"), STAT_ItemInitializationsSkipped, STATGROUP_RPGItems);
+
+/**
+ * Keeps a revision number for every DataTable used by items and the items initialized from it.
+ * When a DataTable is modified in the editor its revision is increased, and only the items whose row
+ * data really changed are initialized again. Outside the editor DataTables don't change, so nothing is tracked.
+ */
+struct FItemDataTableRegistry
+{
+	static FItemDataTableRegistry& Get()
+	{
+		static FItemDataTableRegistry Instance;
+		return Instance;
+	}
+
+#if WITH_EDITOR
+	struct FTableEntry
+	{
+		uint32 Revision = 1;
+		FDelegateHandle ChangedHandle;
+		TSet<TWeakObjectPtr<ABaseItem>> Items;
+	};
+
+	uint32 GetRevision(const UDataTable* DataTable) const
+	{
+		const FTableEntry* Entry = Entries.Find(DataTable);
+		return Entry ? Entry->Revision : 1;
+	}
+
+	void Register(ABaseItem* Item, UDataTable* DataTable)
+	{
+		FTableEntry& Entry = Entries.FindOrAdd(DataTable);
+		if (!Entry.ChangedHandle.IsValid())
+		{
+			TWeakObjectPtr<const UDataTable> WeakDataTable(DataTable);
+			Entry.ChangedHandle = DataTable->OnDataTableChanged().AddLambda([WeakDataTable]()
+			{
+				Get().OnDataTableChanged(WeakDataTable);
+			});
+		}
+		Entry.Items.Add(Item);
+	}
+
+	void Unregister(ABaseItem* Item, const UDataTable* DataTable)
+	{
+		if (FTableEntry* Entry = Entries.Find(DataTable))
+		{
+			Entry->Items.Remove(Item);
+		}
+	}
+
+private:
+	void OnDataTableChanged(TWeakObjectPtr<const UDataTable> DataTable)
+	{
+		FTableEntry* Entry = Entries.Find(DataTable);
+		if (!Entry)
+		{
+			return;
+		}
+
+		++Entry->Revision;
+
+		// Copy the items, reinitializing an item can register or unregister it again
+		const uint32 NewRevision = Entry->Revision;
+		TArray<TWeakObjectPtr<ABaseItem>> Items = Entry->Items.Array();
+		for (const TWeakObjectPtr<ABaseItem>& Item : Items)
+		{
+			if (Item.IsValid())
+			{
+				Item->HandleDataTableChanged(NewRevision);
+			}
+			else
+			{
+				Entries.FindChecked(DataTable).Items.Remove(Item);
+			}
+		}
+	}
+
+	TMap<TWeakObjectPtr<const UDataTable>, FTableEntry> Entries;
+#else
+	uint32 GetRevision(const UDataTable* DataTable) const { return 0; }
+	void Register(ABaseItem* Item, UDataTable* DataTable) { }
+	void Unregister(ABaseItem* Item, const UDataTable* DataTable) { }
+#endif
+};
+
+// Hash of the row fields that ItemInitialization applies to the item
+static uint32 GetItemRowHash(const FItemStruct& ItemData)
+{
+	uint32 Hash = GetTypeHash(static_cast<uint8>(ItemData.MeshType));
+	Hash = HashCombine(Hash, GetTypeHash(ItemData.StaticMesh));
+	Hash = HashCombine(Hash, GetTypeHash(ItemData.SkeletalMesh));
+	return Hash;
+}
 
 // Constructor
 ABaseItem::ABaseItem()
 {
-	// Enable ticking every frame for this actor
-	PrimaryActorTick.bCanEverTick = true;
+	// Items don't tick, so thousands of them streaming in don't register tick functions.
+	// Blueprints implementing the Tick event enable it again, see ChildCanTick on the class
+	PrimaryActorTick.bCanEverTick = false;
+
+	// Items replicate, but they stay dormant until the server changes them. The ones placed in
+	// the map are loaded by the clients and never replicated if they don't change
+	bReplicates = true;
+	SetReplicatingMovement(true);
+	NetDormancy = DORM_Initial;
 
 	// Create mesh components
 	StaticMeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("StaticMeshComponent"));
@@ -22,20 +128,130 @@ void ABaseItem::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
 
+	// Skip the DataTable lookup and mesh setup if nothing changed since the last initialization
+	if (IsInitializationUpToDate())
+	{
+		INC_DWORD_STAT(STAT_ItemInitializationsSkipped);
+		return;
+	}
+
 	// Attempt to initialize the mesh from the DataTable
 	ItemInitialization();
 }
 
+void ABaseItem::BeginDestroy()
+{
+	if (AppliedDataTable)
+	{
+		FItemDataTableRegistry::Get().Unregister(this, AppliedDataTable);
+	}
+
+	Super::BeginDestroy();
+}
+
+void ABaseItem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Push based, the properties are only compared when they were marked dirty
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseItem, ItemDataTable, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseItem, RowName, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABaseItem, bPooled, Params);
+}
+
 // Called when the game starts
 void ABaseItem::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// DORM_Initial only applies to the items placed in the map, the spawned ones are sent once and then sleep
+	if (HasAuthority() && NetDormancy == DORM_Initial && !IsNetStartupActor())
+	{
+		SetNetDormancy(DORM_DormantAll);
+	}
+}
+
+void ABaseItem::RebindItem(UDataTable* InItemDataTable, FName InRowName)
+{
+	if (ItemDataTable != InItemDataTable || RowName != InRowName)
+	{
+		ItemDataTable = InItemDataTable;
+		RowName = InRowName;
+		MarkItemDirty();
+	}
+
+	if (IsInitializationUpToDate())
+	{
+		INC_DWORD_STAT(STAT_ItemInitializationsSkipped);
+		return;
+	}
+
+	ItemInitialization();
+}
+
+void ABaseItem::SetPooled(bool bInPooled)
+{
+	if (bPooled != bInPooled)
+	{
+		bPooled = bInPooled;
+		MarkItemDirty();
+	}
+
+	ApplyPooled();
+}
+
+void ABaseItem::ApplyPooled()
+{
+	SetActorHiddenInGame(bPooled);
+	SetActorEnableCollision(!bPooled);
+	SetActorTickEnabled(!bPooled);
+}
+
+void ABaseItem::OnRep_Pooled()
+{
+	ApplyPooled();
+}
+
+void ABaseItem::OnRep_ItemRow()
+{
+	bItemRowReceived = true;
+}
+
+void ABaseItem::PostRepNotifies()
+{
+	Super::PostRepNotifies();
+
+	if (bItemRowReceived)
+	{
+		bItemRowReceived = false;
+		if (!IsInitializationUpToDate())
+		{
+			ItemInitialization();
+		}
+	}
+}
+
+void ABaseItem::MarkItemDirty()
+{
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseItem, ItemDataTable, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseItem, RowName, this);
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABaseItem, bPooled, this);
+
+	if (HasAuthority())
+	{
+		FlushNetDormancy();
+	}
 }
 
 // Function to process the DataTable and assign the appropriate mesh
 void ABaseItem::ItemInitialization()
 {
+	GENLIB_PERF_SCOPE("ItemInitialization");
+	INC_DWORD_STAT(STAT_ItemInitializationsPerformed);
+	InvalidateInitialization();
+
 	if (!ItemDataTable) // Check if the DataTable is assigned
 	{
 		UE_LOG(ItemLog, Warning, TEXT("ItemDataTable is not assigned in %s"), *GetName());
@@ -60,11 +276,12 @@ void ABaseItem::ItemInitialization()
 			StaticMeshComponent->SetStaticMesh(ItemData->StaticMesh);
 			StaticMeshComponent->SetVisibility(true);
 			SkeletalMeshComponent->SetVisibility(false);
-			UE_LOG(ItemLog, Log, TEXT("A StaticMesh was assigned in %s"), *GetName());
+			UE_LOG(ItemLog, Verbose, TEXT("A StaticMesh was assigned in %s"), *GetName());
 		}
 		else
 		{
 			UE_LOG(ItemLog, Warning, TEXT("StaticMesh is not assigned in row %s"), *RowName.ToString());
+			return;
 		}
 	}
 	else if (ItemData->MeshType == EMeshType::SkeletalMesh)
@@ -75,17 +292,58 @@ void ABaseItem::ItemInitialization()
 			SkeletalMeshComponent->SetSkeletalMesh(ItemData->SkeletalMesh);
 			SkeletalMeshComponent->SetVisibility(true);
 			StaticMeshComponent->SetVisibility(false);
-			UE_LOG(ItemLog, Log, TEXT("A SkeletalMesh was assigned in %s"), *GetName());
+			UE_LOG(ItemLog, Verbose, TEXT("A SkeletalMesh was assigned in %s"), *GetName());
 		}
 		else
 		{
 			UE_LOG(ItemLog, Warning, TEXT("SkeletalMesh is not assigned in row %s"), *RowName.ToString());
+			return;
 		}
 	}
+
+	// Remember what was applied so the next construction can be skipped
+	FItemDataTableRegistry& Registry = FItemDataTableRegistry::Get();
+	Registry.Register(this, ItemDataTable);
+	AppliedDataTable = ItemDataTable;
+	AppliedRowName = RowName;
+	AppliedRevision = Registry.GetRevision(ItemDataTable);
+	AppliedRowHash = GetItemRowHash(*ItemData);
+}
+
+bool ABaseItem::IsInitializationUpToDate() const
+{
+	return AppliedDataTable != nullptr
+		&& AppliedDataTable == ItemDataTable
+		&& AppliedRowName == RowName
+		&& AppliedRevision == FItemDataTableRegistry::Get().GetRevision(ItemDataTable);
+}
+
+void ABaseItem::InvalidateInitialization()
+{
+	if (AppliedDataTable)
+	{
+		FItemDataTableRegistry::Get().Unregister(this, AppliedDataTable);
+	}
+	AppliedDataTable = nullptr;
+	AppliedRowName = NAME_None;
+	AppliedRevision = 0;
+	AppliedRowHash = 0;
+}
+
+void ABaseItem::HandleDataTableChanged(uint32 NewRevision)
+{
+	// Keep the current initialization if the row this item uses didn't change
+	const FItemStruct* ItemData = AppliedDataTable ? AppliedDataTable->FindRow<FItemStruct>(AppliedRowName, TEXT("ABaseItem::HandleDataTableChanged"), false) : nullptr;
+	if (ItemData && GetItemRowHash(*ItemData) == AppliedRowHash)
+	{
+		AppliedRevision = NewRevision;
+		return;
+	}
+
+	ItemInitialization();
 }
 
 void ABaseItem::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 }
-
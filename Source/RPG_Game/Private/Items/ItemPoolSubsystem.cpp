@@ -0,0 +1,94 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Items/ItemPoolSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled Items"), STAT_PooledItems, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Spawns Avoided"), STAT_ItemSpawnsAvoided, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Item Spawns"), STAT_ItemSpawns, STATGROUP_RPGItems);
+
+static int32 GMaxPooledItemsPerClass = 256;
+static FAutoConsoleVariableRef CVarMaxPooledItemsPerClass(
+	TEXT("RPG.ItemPool.MaxPerClass"),
+	GMaxPooledItemsPerClass,
+	TEXT("Maximum number of item actors kept in the pool for each item class."));
+
+void UItemPoolSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_PooledItems, NumPooledItems);
+	Pools.Reset();
+	NumPooledItems = 0;
+
+	Super::Deinitialize();
+}
+
+ABaseItem* UItemPoolSubsystem::AcquireItem(TSubclassOf<ABaseItem> ItemClass, UDataTable* ItemDataTable, FName RowName, const FTransform& Transform)
+{
+	if (!ItemClass)
+	{
+		UE_LOG(ItemLog, Warning, TEXT("AcquireItem called without an ItemClass. %s"), *RPG_LOGS_LINE);
+		return nullptr;
+	}
+
+	// Reuse a pooled item, the construction is not run again, only the row is rebound
+	if (FItemPoolBucket* Bucket = Pools.Find(ItemClass))
+	{
+		while (!Bucket->Items.IsEmpty())
+		{
+			ABaseItem* Item = Bucket->Items.Pop(EAllowShrinking::No);
+			--NumPooledItems;
+			DEC_DWORD_STAT(STAT_PooledItems);
+
+			if (!IsValid(Item))
+			{
+				continue;
+			}
+
+			Item->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+			Item->RebindItem(ItemDataTable, RowName);
+			Item->SetPooled(false);
+
+			++NumSpawnsAvoided;
+			INC_DWORD_STAT(STAT_ItemSpawnsAvoided);
+			return Item;
+		}
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return nullptr;
+	}
+
+	// Bind the row before finishing the spawn, so the construction initializes the item only once
+	ABaseItem* Item = World->SpawnActorDeferred<ABaseItem>(ItemClass, Transform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Item)
+	{
+		Item->RebindItem(ItemDataTable, RowName);
+		Item->FinishSpawning(Transform);
+		INC_DWORD_STAT(STAT_ItemSpawns);
+	}
+	return Item;
+}
+
+void UItemPoolSubsystem::ReleaseItem(ABaseItem* Item)
+{
+	if (!IsValid(Item) || Item->IsPooled())
+	{
+		return;
+	}
+
+	FItemPoolBucket& Bucket = Pools.FindOrAdd(Item->GetClass());
+	if (Bucket.Items.Num() >= GMaxPooledItemsPerClass)
+	{
+		Item->Destroy();
+		return;
+	}
+
+	Item->SetPooled(true);
+	Bucket.Items.Add(Item);
+	++NumPooledItems;
+	INC_DWORD_STAT(STAT_PooledItems);
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Items/PickUpCellData.h"
+#include "Items/PickUpManagerSubsystem.h"
+#include "RPG_Game/RPG_GamePickUpComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "LinkedCellRegistry.h"
+
+#if WITH_EDITOR
+void UPickUpCellData::BuildForLevel(ULevel* Level)
+{
+	TArray<URPG_GamePickUpComponent*> PickUps;
+	TArray<FVector> Locations;
+	for (AActor* Actor : Level->Actors)
+	{
+		if (!Actor || Actor->HasAnyFlags(RF_Transient) || Actor->IsEditorOnly())
+		{
+			continue;
+		}
+
+		TInlineComponentArray<URPG_GamePickUpComponent*> ActorPickUps(Actor);
+		for (URPG_GamePickUpComponent* PickUp : ActorPickUps)
+		{
+			PickUp->CellEntryIndex = INDEX_NONE;
+			if (PickUp->bUsePickUpManager)
+			{
+				PickUps.Add(PickUp);
+				Locations.Add(PickUp->GetComponentLocation());
+			}
+		}
+	}
+
+	if (PickUps.IsEmpty())
+	{
+		Level->RemoveUserDataOfClass(UPickUpCellData::StaticClass());
+		return;
+	}
+
+	UPickUpCellData* CellData = Level->GetAssetUserData<UPickUpCellData>();
+	if (!CellData)
+	{
+		CellData = NewObject<UPickUpCellData>(Level);
+		Level->AddAssetUserData(CellData);
+	}
+
+	TArray<int32> Order;
+	CellData->Index.Build(Locations, UPickUpManagerSubsystem::GetCellSize(), Order);
+	CellData->Components.Reset(Order.Num());
+	CellData->Radii.Reset(Order.Num());
+	CellData->MaxRadius = 0.0f;
+	for (const int32 SourceIndex : Order)
+	{
+		URPG_GamePickUpComponent* PickUp = PickUps[SourceIndex];
+		PickUp->CellEntryIndex = CellData->Components.Add(PickUp);
+		CellData->Radii.Add(PickUp->GetScaledSphereRadius());
+		CellData->MaxRadius = FMath::Max(CellData->MaxRadius, PickUp->GetScaledSphereRadius());
+	}
+}
+
+static FCellDataBuilder GPickUpCellDataBuilder(&UPickUpCellData::BuildForLevel);
+#endif
@@ -0,0 +1,190 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Items/PickUpManagerSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "RPG_Game/RPG_GamePickUpComponent.h"
+#include "RPG_Game/RPG_GameCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+#include "FrameArena.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("PickUp Manager Check"), STAT_PickUpManagerCheck, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Registered PickUps"), STAT_RegisteredPickUps, STATGROUP_RPGItems);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Linked PickUp Cells"), STAT_LinkedPickUpCells, STATGROUP_RPGItems);
+
+static float GPickUpCheckRate = 0.0f;
+static FAutoConsoleVariableRef CVarPickUpCheckRate(
+	TEXT("RPG.PickUp.CheckRate"),
+	GPickUpCheckRate,
+	TEXT("Number of pickup checks per second. 0 checks every frame."));
+
+static float GPickUpCellSize = 1000.0f;
+static FAutoConsoleVariableRef CVarPickUpCellSize(
+	TEXT("RPG.PickUp.CellSize"),
+	GPickUpCellSize,
+	TEXT("Size of the cells of the pickup spatial grid, applied when the world is created and when the cell data of a level is built."));
+
+float UPickUpManagerSubsystem::GetCellSize()
+{
+	return GPickUpCellSize;
+}
+
+void UPickUpManagerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PickUps.SetCellSize(GPickUpCellSize);
+	LinkedCells.Initialize(GetWorld(), GET_STATFNAME(STAT_LinkedPickUpCells));
+}
+
+void UPickUpManagerSubsystem::Deinitialize()
+{
+	DEC_DWORD_STAT_BY(STAT_RegisteredPickUps, PickUps.Num());
+	PickUps.Reset();
+	LinkedCells.Reset();
+
+	Super::Deinitialize();
+}
+
+TStatId UPickUpManagerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickUpManagerSubsystem, STATGROUP_Tickables);
+}
+
+void UPickUpManagerSubsystem::RegisterPickUp(URPG_GamePickUpComponent* PickUp, const FVector& Location)
+{
+	if (!PickUp)
+	{
+		return;
+	}
+
+	const float Radius = PickUp->GetScaledSphereRadius();
+	PickUps.Add({ PickUp, Radius }, Location);
+	MaxPickUpRadius = FMath::Max(MaxPickUpRadius, Radius);
+	INC_DWORD_STAT(STAT_RegisteredPickUps);
+}
+
+void UPickUpManagerSubsystem::UnregisterPickUp(URPG_GamePickUpComponent* PickUp, const FVector& Location)
+{
+	if (PickUps.Remove({ PickUp, 0.0f }, Location))
+	{
+		DEC_DWORD_STAT(STAT_RegisteredPickUps);
+	}
+}
+
+void UPickUpManagerSubsystem::MovePickUp(URPG_GamePickUpComponent* PickUp, const FVector& OldLocation, const FVector& NewLocation)
+{
+	if (PickUp)
+	{
+		// The entry is added again when it changes cell, so it needs its radius
+		PickUps.Move({ PickUp, PickUp->GetScaledSphereRadius() }, OldLocation, NewLocation);
+	}
+}
+
+bool UPickUpManagerSubsystem::LinkCell(ULevel* Level, const URPG_GamePickUpComponent* PickUp, int32 CellEntryIndex)
+{
+	return PickUp && LinkedCells.Link(Level, PickUp, CellEntryIndex, PickUp->GetComponentLocation());
+}
+
+void UPickUpManagerSubsystem::DetachFromCell(const ULevel* Level, int32 CellEntryIndex)
+{
+	LinkedCells.Detach(Level, CellEntryIndex);
+}
+
+void UPickUpManagerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (PickUps.Num() == 0 && LinkedCells.IsEmpty())
+	{
+		return;
+	}
+
+	TimeSinceLastCheck += DeltaTime;
+	if (GPickUpCheckRate > 0.0f && TimeSinceLastCheck < 1.0f / GPickUpCheckRate)
+	{
+		return;
+	}
+	TimeSinceLastCheck = 0.0f;
+
+	CheckPickUps();
+}
+
+/**
+ * Checks the pickups in the cells around every player character.
+ * A pickup is reached when the distance from its center to the axis segment of the capsule is smaller than
+ * the sum of the capsule radius and the radius of the pickup sphere, the same condition than the sphere overlap.
+ * The grids are queried with the sphere bounding the capsule.
+ */
+void UPickUpManagerSubsystem::CheckPickUps()
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickUpManagerCheck);
+	GENLIB_PERF_SCOPE("PickUpManager");
+
+	struct FPickedUp
+	{
+		URPG_GamePickUpComponent* Component;
+		ARPG_GameCharacter* Character;
+	};
+	TArray<FPickedUp, TInlineAllocator<8, FFrameArenaAllocator>> PickedUp;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		ARPG_GameCharacter* Character = PlayerController ? Cast<ARPG_GameCharacter>(PlayerController->GetPawn()) : nullptr;
+		if (!Character)
+		{
+			continue;
+		}
+
+		const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+		const FVector CapsuleCenter = Capsule->GetComponentLocation();
+		const FVector AxisExtent = Capsule->GetUpVector() * Capsule->GetScaledCapsuleHalfHeight_WithoutHemisphere();
+		const FVector AxisStart = CapsuleCenter - AxisExtent;
+		const FVector AxisEnd = CapsuleCenter + AxisExtent;
+		const float CharacterRadius = Capsule->GetScaledCapsuleRadius();
+		const float CharacterHalfHeight = Capsule->GetScaledCapsuleHalfHeight();
+		auto TouchesCapsule = [AxisStart, AxisEnd, CharacterRadius](const FVector& Location, float PickUpRadius)
+		{
+			return FMath::PointDistToSegmentSquared(Location, AxisStart, AxisEnd) <= FMath::Square(CharacterRadius + PickUpRadius);
+		};
+
+		PickUps.ForEachInRadius(CapsuleCenter, CharacterHalfHeight + MaxPickUpRadius,
+			[&PickedUp, &TouchesCapsule, Character](const FPickUpEntry& Entry, const FVector& Location, float DistSquared)
+			{
+				if (TouchesCapsule(Location, Entry.Radius))
+				{
+					// The first character reaching the pickup gets it
+					URPG_GamePickUpComponent* Component = Entry.Component.Get();
+					if (Component && !PickedUp.ContainsByPredicate([Component](const FPickedUp& Pick) { return Pick.Component == Component; }))
+					{
+						PickedUp.Add({ Component, Character });
+					}
+				}
+			});
+
+		LinkedCells.ForEachInRadius(CapsuleCenter,
+			[CharacterHalfHeight](const UPickUpCellData& CellData) { return CharacterHalfHeight + CellData.MaxRadius; },
+			[&PickedUp, &TouchesCapsule, Character](const UPickUpCellData& CellData, int32 Index, const FVector& Location, float DistSquared)
+			{
+				URPG_GamePickUpComponent* Component = CellData.Components[Index];
+				if (TouchesCapsule(Location, CellData.Radii[Index])
+					&& !PickedUp.ContainsByPredicate([Component](const FPickedUp& Pick) { return Pick.Component == Component; }))
+				{
+					PickedUp.Add({ Component, Character });
+				}
+			});
+	}
+
+	// Notify after the queries, the pickups unregister themselves from the grid
+	for (const FPickedUp& Pick : PickedUp)
+	{
+		if (IsValid(Pick.Component))
+		{
+			Pick.Component->NotifyPickUp(Pick.Character);
+		}
+	}
+}
@@ -0,0 +1,84 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Net/RPGReplicationGraph.h"
+#include "Items/BaseItem.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "GameplayPerfTracker.h"
+#include "UObject/UObjectIterator.h"
+
+void URPGReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	// The cull distance also decides how many cells of the grid an actor is added to
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		if (Class->IsChildOf(ABaseItem::StaticClass()) && !Class->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists))
+		{
+			GlobalActorReplicationInfoMap.GetClassInfo(Class).SetCullDistanceSquared(FMath::Square(ItemCullDistance));
+		}
+	}
+}
+
+void URPGReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = GridSpatialBias;
+}
+
+bool URPGReplicationGraph::IsDormantByDefault(const AActor* Actor)
+{
+	// Items replicate their movement, they only sleep through their DORM_Initial dormancy, routed by NetDormancy
+	const UFPP_InteractableComponent* Interactable = Actor->FindComponentByClass<UFPP_InteractableComponent>();
+	return Interactable && Interactable->IsOwnerDormantByDefault();
+}
+
+void URPGReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+	if (Actor->bAlwaysRelevant || Actor->bOnlyRelevantToOwner)
+	{
+		Super::RouteAddNetworkActorToNodes(ActorInfo, GlobalInfo);
+		return;
+	}
+
+	// Dormant actors are kept as static while they sleep and only checked again when they wake up
+	if (Actor->NetDormancy > DORM_Awake || IsDormantByDefault(Actor))
+	{
+		DormancyRoutedActors.Add(Actor);
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+	}
+	else
+	{
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+	}
+}
+
+void URPGReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.Actor;
+	if (Actor->bAlwaysRelevant || Actor->bOnlyRelevantToOwner)
+	{
+		Super::RouteRemoveNetworkActorToNodes(ActorInfo);
+		return;
+	}
+
+	if (DormancyRoutedActors.Remove(Actor) > 0)
+	{
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+	}
+	else
+	{
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+	}
+}
+
+int32 URPGReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	// Measured by the benchmark as the net tick of the server
+	GENLIB_PERF_SCOPE("ServerReplicateActors");
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
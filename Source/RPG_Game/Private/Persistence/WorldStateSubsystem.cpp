@@ -0,0 +1,359 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#include "Persistence/WorldStateSubsystem.h"
+#include "RPG_Game/RPG_Game.h"
+#include "Components/FPP_InteractableComponent.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "Hash/CityHash.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "GameplayPerfTracker.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_CYCLE_STAT(TEXT("World State Apply"), STAT_WorldStateApply, STATGROUP_RPGItems);
+
+static bool GWorldStateAutoLoad = true;
+static FAutoConsoleVariableRef CVarWorldStateAutoLoad(
+	TEXT("RPG.WorldState.AutoLoad"),
+	GWorldStateAutoLoad,
+	TEXT("If true, the saved state of the map is applied when the world begins play."));
+
+namespace WorldState
+{
+	// Header of the save files, the version changes with the layout of the states or the ids.
+	// 2: the ids hash the lowercase UTF-8 key, the same on every platform
+	constexpr uint32 FileMagic = 0x57535445; // 'WSTE'
+	constexpr uint32 FileVersion = 2;
+
+	// Maximum cooldown that can be saved, in tenths of second
+	constexpr float MaxCooldownDeciseconds = MAX_uint16;
+}
+
+bool UWorldStateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UWorldStateSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The subsystems begin play before the actors, so the saved state is in place when they do
+	if (GWorldStateAutoLoad && InWorld.GetNetMode() != NM_Client)
+	{
+		LoadWorldState();
+	}
+}
+
+uint64 UWorldStateSubsystem::GetStableId(const AActor* Actor)
+{
+	// Only the actors loaded with the level have a name that is the same in every session
+	if (!Actor || !Actor->IsNetStartupActor() || !Actor->GetLevel())
+	{
+		return 0;
+	}
+
+	const FString LevelName = UWorld::RemovePIEPrefix(Actor->GetLevel()->GetOutermost()->GetName());
+	const FString Key = FString::Printf(TEXT("%s.%s"), *LevelName, *Actor->GetFName().ToString()).ToLower();
+
+	// TCHAR is 2 or 4 bytes depending on the platform, the hashed encoding must not be
+	const FTCHARToUTF8 Utf8Key(*Key);
+	return CityHash64(Utf8Key.Get(), Utf8Key.Length());
+}
+
+void UWorldStateSubsystem::MarkPickedUp(const AActor* Actor)
+{
+	if (const uint64 Id = GetStableId(Actor))
+	{
+		States.FindOrAdd(Id).Flags |= EWorldActorStateFlags::PickedUp;
+	}
+}
+
+bool UWorldStateSubsystem::SaveWorldState()
+{
+	CaptureStates();
+
+	TArray<uint8> Bytes;
+	WriteStates(States, Bytes);
+
+	const FString FilePath = GetSaveFilePath();
+	if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+	{
+		UE_LOG(RPGLog, Error, TEXT("Failed to write the world state to %s. %s"), *FilePath, *RPG_LOGS_LINE);
+		return false;
+	}
+
+	UE_LOG(RPGLog, Log, TEXT("World state saved: %d actors, %d bytes."), States.Num(), Bytes.Num());
+	return true;
+}
+
+bool UWorldStateSubsystem::LoadWorldState()
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetSaveFilePath(), FILEREAD_Silent))
+	{
+		// No save yet, the levels stay as they are
+		return false;
+	}
+
+	TMap<uint64, FWorldActorState> LoadedStates;
+	if (!ReadStates(Bytes, LoadedStates))
+	{
+		UE_LOG(RPGLog, Error, TEXT("The world state file %s is not valid. %s"), *GetSaveFilePath(), *RPG_LOGS_LINE);
+		return false;
+	}
+	States = MoveTemp(LoadedStates);
+	LastReadSeconds = FPlatformTime::Seconds() - StartTime;
+
+	ApplyStates();
+
+	UE_LOG(RPGLog, Log, TEXT("World state loaded: %d actors, read %.2f ms, applied %.2f ms."), States.Num(), LastReadSeconds * 1000.0, LastApplySeconds * 1000.0);
+	return true;
+}
+
+void UWorldStateSubsystem::WriteStates(const TMap<uint64, FWorldActorState>& InStates, TArray<uint8>& OutBytes)
+{
+	// Sorted so the same states always give the same file
+	TArray<uint64> Ids;
+	InStates.GenerateKeyArray(Ids);
+	Ids.Sort();
+
+	// Id, flags, cooldown bit and the cooldown only if there is one
+	FBitWriter BitWriter(Ids.Num() * (64 + EWorldActorStateFlags::NumBits + 1), true);
+	for (uint64 Id : Ids)
+	{
+		const FWorldActorState& State = InStates.FindChecked(Id);
+		uint8 Flags = State.Flags;
+		uint16 Cooldown = State.CooldownDeciseconds;
+
+		BitWriter << Id;
+		BitWriter.SerializeBits(&Flags, EWorldActorStateFlags::NumBits);
+		BitWriter.WriteBit(Cooldown > 0);
+		if (Cooldown > 0)
+		{
+			BitWriter << Cooldown;
+		}
+	}
+
+	uint32 Magic = WorldState::FileMagic;
+	uint32 Version = WorldState::FileVersion;
+	int32 NumStates = Ids.Num();
+	int64 NumBits = BitWriter.GetNumBits();
+
+	OutBytes.Reset();
+	FMemoryWriter Writer(OutBytes);
+	Writer << Magic << Version << NumStates << NumBits;
+	Writer.Serialize(BitWriter.GetData(), BitWriter.GetNumBytes());
+}
+
+bool UWorldStateSubsystem::ReadStates(const TArray<uint8>& Bytes, TMap<uint64, FWorldActorState>& OutStates)
+{
+	uint32 Magic = 0;
+	uint32 Version = 0;
+	int32 NumStates = 0;
+	int64 NumBits = 0;
+
+	FMemoryReader Reader(Bytes);
+	Reader << Magic << Version << NumStates << NumBits;
+	const int64 NumBytes = (NumBits + 7) >> 3;
+	if (Reader.IsError() || Magic != WorldState::FileMagic || Version != WorldState::FileVersion
+		|| NumStates < 0 || NumBits < 0 || Reader.Tell() + NumBytes > Bytes.Num())
+	{
+		return false;
+	}
+
+	FBitReader BitReader(const_cast<uint8*>(Bytes.GetData() + Reader.Tell()), NumBits);
+	OutStates.Reset();
+	OutStates.Reserve(NumStates);
+	for (int32 Index = 0; Index < NumStates; ++Index)
+	{
+		uint64 Id = 0;
+		FWorldActorState State;
+
+		BitReader << Id;
+		BitReader.SerializeBits(&State.Flags, EWorldActorStateFlags::NumBits);
+		if (BitReader.ReadBit())
+		{
+			BitReader << State.CooldownDeciseconds;
+		}
+
+		if (BitReader.IsError())
+		{
+			OutStates.Reset();
+			return false;
+		}
+		OutStates.Add(Id, State);
+	}
+	return true;
+}
+
+/**
+ * Goes once through the actors of the loaded levels and applies their saved state.
+ * The picked up actors are destroyed after the pass, the interactables get their state and cooldown back.
+ */
+void UWorldStateSubsystem::ApplyStates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_WorldStateApply);
+	GENLIB_PERF_SCOPE("WorldStateApply");
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (States.IsEmpty())
+	{
+		LastApplySeconds = 0.0;
+		return;
+	}
+
+	TArray<AActor*> PickedUpActors;
+	for (const ULevel* Level : GetWorld()->GetLevels())
+	{
+		for (AActor* Actor : Level->Actors)
+		{
+			const FWorldActorState* State = States.Find(GetStableId(Actor));
+			if (!State)
+			{
+				continue;
+			}
+
+			if (State->Flags & EWorldActorStateFlags::PickedUp)
+			{
+				PickedUpActors.Add(Actor);
+				continue;
+			}
+
+			if (UFPP_InteractableComponent* Interactable = Actor->FindComponentByClass<UFPP_InteractableComponent>())
+			{
+				const EInteractableState InteractableState = (State->Flags & EWorldActorStateFlags::Disabled) ? EInteractableState::Disabled
+					: (State->Flags & EWorldActorStateFlags::Opened) ? EInteractableState::Opened : EInteractableState::Idle;
+				Interactable->RestoreState(InteractableState, State->CooldownDeciseconds * 0.1f);
+			}
+		}
+	}
+
+	for (AActor* Actor : PickedUpActors)
+	{
+		Actor->Destroy();
+	}
+
+	LastApplySeconds = FPlatformTime::Seconds() - StartTime;
+}
+
+void UWorldStateSubsystem::CaptureStates()
+{
+	for (const ULevel* Level : GetWorld()->GetLevels())
+	{
+		for (const AActor* Actor : Level->Actors)
+		{
+			const UFPP_InteractableComponent* Interactable = Actor ? Actor->FindComponentByClass<UFPP_InteractableComponent>() : nullptr;
+			const uint64 Id = Interactable ? GetStableId(Actor) : 0;
+			if (!Id)
+			{
+				continue;
+			}
+
+			FWorldActorState State;
+			if (const FWorldActorState* SavedState = States.Find(Id))
+			{
+				State.Flags = SavedState->Flags & EWorldActorStateFlags::PickedUp;
+			}
+			switch (Interactable->GetInteractableState())
+			{
+			case EInteractableState::Opened: State.Flags |= EWorldActorStateFlags::Opened; break;
+			case EInteractableState::Disabled: State.Flags |= EWorldActorStateFlags::Disabled; break;
+			default: break;
+			}
+			State.CooldownDeciseconds = static_cast<uint16>(FMath::Min(FMath::CeilToFloat(Interactable->GetCooldownRemaining() * 10.0f), WorldState::MaxCooldownDeciseconds));
+
+			// Only the differences from the level defaults are kept
+			if (State.IsDefault())
+			{
+				States.Remove(Id);
+			}
+			else
+			{
+				States.Add(Id, State);
+			}
+		}
+	}
+}
+
+FString UWorldStateSubsystem::GetSaveFilePath() const
+{
+	const FString MapName = FPackageName::GetShortName(UWorld::RemovePIEPrefix(GetWorld()->GetOutermost()->GetName()));
+	return FPaths::ProjectSavedDir() / TEXT("WorldState") / MapName + TEXT(".bin");
+}
+
+namespace WorldStateBench
+{
+	/**
+	 * Measures the persistence of a level with many interactables without spawning them:
+	 * the states are generated, written, read back and looked up with the ids of every actor of the level.
+	 */
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 NumActors = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+		const float ChangedRatio = Args.Num() > 1 ? FMath::Clamp(FCString::Atof(*Args[1]), 0.0f, 1.0f) : 0.25f;
+
+		FRandomStream Random(0x5EED);
+		TArray<FString> ActorKeys;
+		ActorKeys.Reserve(NumActors);
+		TMap<uint64, FWorldActorState> States;
+		for (int32 Index = 0; Index < NumActors; ++Index)
+		{
+			const FString& Key = ActorKeys.Add_GetRef(FString::Printf(TEXT("/Game/Maps/BenchLevel.BP_Interactable_C_%d"), Index));
+			if (Random.FRand() < ChangedRatio)
+			{
+				FWorldActorState State;
+				State.Flags = static_cast<uint8>(1 << Random.RandHelper(EWorldActorStateFlags::NumBits));
+				State.CooldownDeciseconds = Random.FRand() < 0.2f ? static_cast<uint16>(Random.RandRange(1, 600)) : 0;
+				States.Add(CityHash64(reinterpret_cast<const char*>(*Key), Key.Len() * sizeof(TCHAR)), State);
+			}
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		TArray<uint8> Bytes;
+		UWorldStateSubsystem::WriteStates(States, Bytes);
+		const double WriteSeconds = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		TMap<uint64, FWorldActorState> ReadStates;
+		const bool bRead = UWorldStateSubsystem::ReadStates(Bytes, ReadStates);
+		const double ReadSeconds = FPlatformTime::Seconds() - StartTime;
+
+		// Same work than the apply pass without the actors: an id per actor and a lookup
+		StartTime = FPlatformTime::Seconds();
+		int32 NumFound = 0;
+		for (const FString& Key : ActorKeys)
+		{
+			NumFound += ReadStates.Contains(CityHash64(reinterpret_cast<const char*>(*Key), Key.Len() * sizeof(TCHAR))) ? 1 : 0;
+		}
+		const double LookupSeconds = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(RPGLog, Display, TEXT("World state bench: %d actors, %d changed, %s. %d bytes (%.1f per state), write %.2f ms, read %.2f ms, lookup %.2f ms."),
+			NumActors, States.Num(), bRead && NumFound == States.Num() ? TEXT("valid") : TEXT("INVALID"), Bytes.Num(),
+			States.Num() > 0 ? static_cast<float>(Bytes.Num()) / States.Num() : 0.0f, WriteSeconds * 1000.0, ReadSeconds * 1000.0, LookupSeconds * 1000.0);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs WorldStateBenchCommand(
+	TEXT("RPG.WorldState.Bench"),
+	TEXT("Measures the save and load of the world state of a synthetic level. Usage: RPG.WorldState.Bench [NumActors=100000] [ChangedRatio=0.25]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&WorldStateBench::Run));
+
+static FAutoConsoleCommandWithWorldAndArgs WorldStateSaveCommand(
+	TEXT("RPG.WorldState.Save"),
+	TEXT("Saves the state of the level actors of the current map."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (UWorldStateSubsystem* WorldState = World ? World->GetSubsystem<UWorldStateSubsystem>() : nullptr)
+		{
+			WorldState->SaveWorldState();
+		}
+	}));
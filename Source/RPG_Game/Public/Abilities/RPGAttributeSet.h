@@ -0,0 +1,53 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AttributeSet.h"
+#include "AbilitySystemComponent.h"
+#include "RPGAttributeSet.generated.h"
+
+// Getter, setter and initializer of an attribute
+#define RPG_ATTRIBUTE_ACCESSORS(ClassName, PropertyName) \
+	GAMEPLAYATTRIBUTE_PROPERTY_GETTER(ClassName, PropertyName) \
+	GAMEPLAYATTRIBUTE_VALUE_GETTER(PropertyName) \
+	GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
+	GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
+
+/**
+ * Health of the combatants.
+ * The damage effects modify the Damage meta attribute, which is turned into a loss of Health
+ * once the effect is executed.
+ */
+UCLASS()
+class RPG_GAME_API URPGAttributeSet : public UAttributeSet
+{
+	GENERATED_BODY()
+
+public:
+	URPGAttributeSet();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue) override;
+	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_Health)
+	FGameplayAttributeData Health;
+	RPG_ATTRIBUTE_ACCESSORS(URPGAttributeSet, Health)
+
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes", ReplicatedUsing = OnRep_MaxHealth)
+	FGameplayAttributeData MaxHealth;
+	RPG_ATTRIBUTE_ACCESSORS(URPGAttributeSet, MaxHealth)
+
+	// Damage received by an effect, only exists on the server while the effect is executed
+	UPROPERTY(BlueprintReadOnly, Category = "Attributes")
+	FGameplayAttributeData Damage;
+	RPG_ATTRIBUTE_ACCESSORS(URPGAttributeSet, Damage)
+
+protected:
+	UFUNCTION()
+	void OnRep_Health(const FGameplayAttributeData& OldHealth);
+
+	UFUNCTION()
+	void OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth);
+};
@@ -0,0 +1,20 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "RPGDamageEffect.generated.h"
+
+/**
+ * Instant effect adding the SetByCaller.Damage magnitude of its spec to the Damage attribute.
+ * Used by the damage pipeline when no other damage effect is configured.
+ */
+UCLASS()
+class RPG_GAME_API URPGDamageEffect : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	URPGDamageEffect();
+};
@@ -0,0 +1,113 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Pawn.h"
+#include "AbilitySystemInterface.h"
+#include "RPGBenchmarkActors.generated.h"
+
+class UCameraComponent;
+class UBoxComponent;
+class UFPP_InteractorComponent;
+class UFPP_InteractableComponent;
+class UCapsuleComponent;
+class UAbilitySystemComponent;
+class URPGAttributeSet;
+class USkeletalMeshComponent;
+class UEquipmentComponent;
+
+/**
+ * Pawn spawned by the benchmarks to run the interaction focus detection.
+ * It keeps turning around so the detection traces hit different interactables every frame.
+ */
+UCLASS(NotPlaceable)
+class RPG_GAME_API ARPGBenchmarkPawn : public APawn
+{
+	GENERATED_BODY()
+
+public:
+	ARPGBenchmarkPawn();
+
+	virtual void Tick(float DeltaTime) override;
+
+	// Degrees per second the pawn turns around
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Benchmark")
+	float TurnRate = 90.0f;
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UCameraComponent> CameraComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UFPP_InteractorComponent> InteractorComponent;
+};
+
+/**
+ * Interactable actor spawned by the benchmarks, a box blocking the detection traces.
+ */
+UCLASS(NotPlaceable)
+class RPG_GAME_API ARPGBenchmarkInteractable : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARPGBenchmarkInteractable();
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UBoxComponent> BoxComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UFPP_InteractableComponent> InteractableComponent;
+};
+
+/**
+ * Combatant spawned by the benchmarks, a capsule with an ability system and health that takes
+ * the damage of the projectiles and of the simulated hits.
+ */
+UCLASS(NotPlaceable)
+class RPG_GAME_API ARPGBenchmarkCombatant : public AActor, public IAbilitySystemInterface
+{
+	GENERATED_BODY()
+
+public:
+	ARPGBenchmarkCombatant();
+
+	virtual UAbilitySystemComponent* GetAbilitySystemComponent() const override { return AbilitySystemComponent; }
+
+protected:
+	virtual void BeginPlay() override;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UCapsuleComponent> CapsuleComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	UPROPERTY()
+	TObjectPtr<URPGAttributeSet> AttributeSet;
+};
+
+/**
+ * Character body spawned by the benchmarks to measure the rendering cost of the equipment.
+ */
+UCLASS(NotPlaceable)
+class RPG_GAME_API ARPGBenchmarkEquippedCharacter : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ARPGBenchmarkEquippedCharacter();
+
+	FORCEINLINE UEquipmentComponent* GetEquipmentComponent() const { return EquipmentComponent; }
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<USkeletalMeshComponent> BodyComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Component")
+	TObjectPtr<UEquipmentComponent> EquipmentComponent;
+};
@@ -0,0 +1,230 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "RPGBenchmarkSubsystem.generated.h"
+
+class ABaseItem;
+class ARPG_GameProjectile;
+class UDataTable;
+class USkeletalMesh;
+class FJsonObject;
+
+/**
+ * Settings of a benchmark run. Every value can be set from the command line or the console command
+ * with the key shown in the comment, e.g. -BenchInteractors=64 -BenchFrames=1000.
+ */
+struct FRPGBenchmarkConfig
+{
+	// BenchName=, used to name the report and the baseline files
+	FString Name = TEXT("Default");
+
+	// BenchInteractors=, pawns running the interaction focus detection
+	int32 NumInteractors = 16;
+
+	// BenchInteractables=, actors with an interactable component
+	int32 NumInteractables = 1000;
+
+	// BenchItems=, item actors spawned through the item pool
+	int32 NumItems = 1000;
+
+	// BenchWeapons=, weapons firing projectiles
+	int32 NumWeapons = 8;
+
+	// BenchRPM=, rounds per minute of every weapon
+	float RoundsPerMinute = 600.0f;
+
+	// BenchProjectileLOD=, lowers the simulation detail of the far projectiles. 0 keeps all of them at full detail
+	bool bProjectileSignificance = true;
+
+	// BenchCombatants=, actors with an ability system taking damage
+	int32 NumCombatants = 0;
+
+	// BenchHitsPerSecond=, simulated hits on the combatants sent to the damage pipeline
+	float HitsPerSecond = 2000.0f;
+
+	// BenchEquipped=, characters wearing the equipment items of the benchmark
+	int32 NumEquippedCharacters = 0;
+
+	// BenchMergeEquipment=, merges the armor pieces into the body. 0 keeps a skinned component per piece
+	bool bMergeEquipment = true;
+
+	// BenchWarmup=, frames run before measuring
+	int32 WarmupFrames = 60;
+
+	// BenchFrames=, frames measured
+	int32 NumFrames = 600;
+
+	// BenchRadius=, radius of the area where the actors are spawned
+	float SpawnRadius = 5000.0f;
+
+	// BenchTolerance=, relative increase over the baseline considered a regression
+	float RegressionTolerance = 0.1f;
+
+	// Reads the values present in a list of Key=Value parameters
+	void Parse(const TCHAR* Params);
+
+	TSharedRef<FJsonObject> ToJson() const;
+};
+
+/**
+ * Headless performance benchmark of the gameplay systems.
+ * It spawns interactor pawns, interactables, items and firing weapons, runs a fixed number of frames,
+ * and writes a JSON report in Saved/Benchmarks with the frame time percentiles, the game thread time
+ * per gameplay scope and the memory used. The report is compared against a stored baseline and any
+ * regression is reported as a failure.
+ *
+ * Run it with "-RPGBenchmark" on the command line (e.g. with -nullrhi -unattended), which exits with
+ * code 1 on regression, with the console command RPG.Bench.Run [Key=Value...], or with the RPG.Benchmark
+ * automation tests (Session Frontend, or -ExecCmds="Automation RunTests RPG.Benchmark" in CI).
+ * -BenchUpdateBaseline stores the report as the new baseline.
+ *
+ * The projectiles live 3 seconds, so BenchWeapons=67 BenchRPM=600 keeps about 2000 of them alive.
+ * Running it with BenchProjectileLOD=0 and 1 under different names compares the cost of the full simulation.
+ * BenchCombatants=200 measures the damage pipeline, reporting the GameplayEffects applied per second.
+ * BenchEquipped=100 with BenchMergeEquipment=0 and 1 compares the draw calls and the render thread time
+ * of separate and merged equipment meshes. It needs a rendering RHI.
+ * The net tick of the server is measured by the ServerReplicateActors scope of URPGReplicationGraph: run the
+ * benchmark on a listen or dedicated server with BenchItems=50000, connect local clients (e.g. 100 instances
+ * with -nullrhi) before the warmup ends, and the report includes the number of connections.
+ */
+UCLASS(config=Game)
+class RPG_GAME_API URPGBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Spawns the benchmark scenario and starts measuring after the warmup frames.
+	 *
+	 * @param InConfig Settings of the benchmark.
+	 * @param bInExitWhenDone If true the application exits when the benchmark finishes, with code 1 on regression.
+	 * @return False if a benchmark is already running.
+	 */
+	bool StartBenchmark(const FRPGBenchmarkConfig& InConfig, bool bInExitWhenDone);
+
+	FORCEINLINE bool IsRunning() const { return State != EBenchmarkState::Idle; }
+
+	// Result of the last finished run: true if it regressed over the baseline
+	FORCEINLINE bool HasRegressed() const { return bLastRunRegressed; }
+
+	// Report written by the last finished run
+	FORCEINLINE const FString& GetReportPath() const { return ReportPath; }
+
+	/**
+	 * Returns why a config can't run with the assets configured, e.g. items without ItemDataTable.
+	 *
+	 * @param InConfig Settings of the benchmark.
+	 * @return Empty if the whole config can run.
+	 */
+	FString GetMissingSetup(const FRPGBenchmarkConfig& InConfig) const;
+
+	// Projectile fired by the benchmark weapons, ARPG_GameProjectile if not set
+	UPROPERTY(Config)
+	TSoftClassPtr<ARPG_GameProjectile> ProjectileClass;
+
+	// Item class spawned by the benchmark, ABaseItem if not set
+	UPROPERTY(Config)
+	TSoftClassPtr<ABaseItem> ItemClass;
+
+	// DataTable and row used by the benchmark items
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> ItemDataTable;
+
+	UPROPERTY(Config)
+	FName ItemRowName;
+
+	// DataTable, body mesh and items worn by the benchmark equipped characters
+	UPROPERTY(Config)
+	TSoftObjectPtr<UDataTable> EquipmentDataTable;
+
+	UPROPERTY(Config)
+	TSoftObjectPtr<USkeletalMesh> EquipmentBaseMesh;
+
+	UPROPERTY(Config)
+	TArray<FName> EquipmentItems;
+
+private:
+	enum class EBenchmarkState : uint8
+	{
+		Idle,
+		Warmup,
+		Measuring
+	};
+
+	struct FBenchmarkWeapon
+	{
+		FVector Location;
+		FRotator Rotation;
+		float TimeSinceLastShot = 0.0f;
+	};
+
+	// Spawns all the actors of the scenario
+	void SpawnScenario();
+
+	// Fires the benchmark weapons according to their rate of fire
+	void FireWeapons(float DeltaTime);
+
+	// Sends the simulated hits of the frame to the damage pipeline
+	void SimulateHits(float DeltaTime);
+
+	// Writes the report, compares it with the baseline and cleans up the scenario
+	void FinishBenchmark();
+
+	TSharedRef<FJsonObject> BuildReport() const;
+
+	/**
+	 * Compares a report with the baseline report.
+	 *
+	 * @return True if any measure regressed over the tolerance of the config.
+	 */
+	bool CompareWithBaseline(const FJsonObject& Report, const FJsonObject& Baseline) const;
+
+	// Gives back to the console variables changed by the run the values they had before it
+	void RestoreConsoleVariables() const;
+
+	FRPGBenchmarkConfig Config;
+	EBenchmarkState State = EBenchmarkState::Idle;
+	bool bExitWhenDone = false;
+	bool bLastRunRegressed = false;
+	FString ReportPath;
+
+	// Value of RPG.Projectile.Significance before the run
+	bool bSavedProjectileSignificance = true;
+	int32 FrameIndex = 0;
+	double LastFrameSeconds = 0.0;
+
+	TArray<float> FrameTimesMs;
+	TArray<float> GameThreadTimesMs;
+	TArray<float> RenderThreadTimesMs;
+	TArray<float> DrawCalls;
+
+	// Live projectiles sampled every measured frame, in total and per significance level
+	TArray<float> LiveProjectiles;
+	TStaticArray<TArray<float>, 3> ProjectilesPerSignificance;
+
+	// Combatants receiving the simulated hits, and the hits left over from the previous frames
+	TArray<TWeakObjectPtr<AActor>> Combatants;
+	float PendingHits = 0.0f;
+	FRandomStream HitsRandom;
+
+	// Damage pipeline totals when the measure started
+	uint64 DamageRecordsAtStart = 0;
+	uint64 DamageEffectsAtStart = 0;
+	TArray<FBenchmarkWeapon> Weapons;
+	uint64 StartUsedPhysical = 0;
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> SpawnedActors;
+
+	UPROPERTY()
+	TObjectPtr<UClass> LoadedProjectileClass;
+};
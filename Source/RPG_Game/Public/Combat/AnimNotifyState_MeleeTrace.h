@@ -0,0 +1,22 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "AnimNotifyState_MeleeTrace.generated.h"
+
+/**
+ * Marks the active frames of a melee attack. The melee trace component of the owner traces the swing
+ * while the notify is active.
+ */
+UCLASS(meta=(DisplayName="Melee Trace"))
+class RPG_GAME_API UAnimNotifyState_MeleeTrace : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NotifyBegin(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, float TotalDuration, const FAnimNotifyEventReference& EventReference) override;
+	virtual void NotifyEnd(USkeletalMeshComponent* MeshComp, UAnimSequenceBase* Animation, const FAnimNotifyEventReference& EventReference) override;
+	virtual FString GetNotifyName_Implementation() const override;
+};
@@ -0,0 +1,74 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/RPGEnums.h"
+#include "DamagePipelineSubsystem.generated.h"
+
+class UGameplayEffect;
+
+/**
+ * A hit waiting to be turned into damage.
+ */
+struct FDamageRecord
+{
+	TWeakObjectPtr<AActor> Target;
+	TWeakObjectPtr<AActor> Instigator;
+	float Amount = 0.0f;
+	EDamageSource Source = EDamageSource::Projectile;
+};
+
+/**
+ * Applies the damage of the hits of a frame in a single batch on the server.
+ * The projectiles, the hitscan shots and the melee swings enqueue their hits, and once all the actors and
+ * the tickable subsystems ticked, the hits of the same instigator on the same target are merged and applied
+ * with a single damage GameplayEffect to the ability system component of the target.
+ */
+UCLASS(config=Game)
+class RPG_GAME_API UDamagePipelineSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * Queues a hit to be applied at the end of the frame. Ignored on clients.
+	 *
+	 * @param Record The hit, targets without ability system component receive no damage.
+	 */
+	void EnqueueDamage(const FDamageRecord& Record);
+
+	// Returns the number of hits waiting to be applied
+	FORCEINLINE int32 GetNumPendingRecords() const { return PendingRecords.Num(); }
+
+	// Totals since the world started, used to measure the throughput of the pipeline
+	FORCEINLINE uint64 GetNumRecordsProcessed() const { return NumRecordsProcessed; }
+	FORCEINLINE uint64 GetNumEffectsApplied() const { return NumEffectsApplied; }
+
+	// Effect applied to the targets, with the damage as SetByCaller.Damage magnitude. URPGDamageEffect if not set
+	UPROPERTY(Config)
+	TSoftClassPtr<UGameplayEffect> DamageEffectClass;
+
+private:
+	void HandleWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaTime);
+
+	// Merges the pending hits and applies them
+	void ProcessQueue();
+
+	// Applies the merged damage of an instigator to a target. Returns true if an effect was applied
+	bool ApplyDamage(AActor* Target, AActor* Instigator, float Amount) const;
+
+	TArray<FDamageRecord> PendingRecords;
+
+	UPROPERTY()
+	TSubclassOf<UGameplayEffect> LoadedDamageEffectClass;
+
+	FDelegateHandle PostActorTickHandle;
+	uint64 NumRecordsProcessed = 0;
+	uint64 NumEffectsApplied = 0;
+};
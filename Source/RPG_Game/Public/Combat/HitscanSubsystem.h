@@ -0,0 +1,86 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HitscanSubsystem.generated.h"
+
+class ULagCompensationSubsystem;
+
+/**
+ * A single hitscan shot waiting to be resolved.
+ */
+struct FHitscanShot
+{
+	// Actor firing the shot, ignored by the traces
+	TWeakObjectPtr<AActor> Instigator;
+
+	FVector Start = FVector::ZeroVector;
+
+	// Normalized direction of the shot, with the spread already applied
+	FVector Direction = FVector::ForwardVector;
+
+	float Range = 10000.0f;
+
+	// Speed used to compute the impulse applied to physics objects, like a projectile of this speed
+	float ImpulseSpeed = 3000.0f;
+
+	// Damage dealt to every actor hit
+	float Damage = 0.0f;
+
+	// Maximum number of surfaces hit by the shot, including the penetrated ones
+	int32 MaxHits = 1;
+
+	// Maximum thickness of a surface the shot can go through
+	float MaxPenetrationThickness = 0.0f;
+
+	ECollisionChannel TraceChannel = ECC_Visibility;
+
+	// Server time seen by a remote shooter, the characters are hit where they were at that time. Negative hits them where they are
+	double RewindTime = -1.0;
+};
+
+/**
+ * Resolves the hitscan shots fired during a frame in a single batched pass.
+ * The weapons queue their shots, and after all the actors ticked, the scene queries of every shot
+ * run in parallel. The hits are then applied on the game thread with the same impulse logic as the projectiles.
+ * The shots of remote players are traced against the characters rewound by the lag compensation.
+ */
+UCLASS()
+class RPG_GAME_API UHitscanSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Queues a shot to be resolved at the end of the frame
+	void QueueShot(const FHitscanShot& Shot);
+
+	// Returns the number of shots waiting to be resolved
+	FORCEINLINE int32 GetNumPendingShots() const { return PendingShots.Num(); }
+
+private:
+	// Traces all the pending shots and applies their hits
+	void ResolveShots();
+
+	/**
+	 * Traces a shot, going through thin surfaces until the hits budget is spent. Runs on worker threads.
+	 *
+	 * @param World The world traced.
+	 * @param LagCompensation Rewinds the characters for the shots with a rewind time, can be null.
+	 * @param CompensatedActors Characters the scene traces of the rewound shots ignore, they are traced rewound instead.
+	 * @param Shot The shot.
+	 * @param OutHits The surfaces hit, in order.
+	 */
+	static void TraceShot(const UWorld* World, const ULagCompensationSubsystem* LagCompensation, const TArray<AActor*>& CompensatedActors,
+		const FHitscanShot& Shot, TArray<FHitResult, TInlineAllocator<4>>& OutHits);
+
+	TArray<FHitscanShot> PendingShots;
+	TArray<TArray<FHitResult, TInlineAllocator<4>>> ShotHits;
+
+	// Characters registered to the lag compensation, gathered once per resolve
+	TArray<AActor*> CompensatedActors;
+};
@@ -0,0 +1,127 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LagCompensationSubsystem.generated.h"
+
+class ACharacter;
+
+/**
+ * Compact state of the hitbox of a character at a given server time: its collision capsule.
+ */
+struct FHitboxSnapshot
+{
+	double Time = 0.0;
+	FVector CapsuleCenter = FVector::ZeroVector;
+	FQuat4f CapsuleRotation = FQuat4f::Identity;
+	float CapsuleRadius = 0.0f;
+	float CapsuleHalfHeight = 0.0f;
+
+	// Interpolates two snapshots, Alpha 0 returns A and 1 returns B
+	static FHitboxSnapshot Interpolate(const FHitboxSnapshot& A, const FHitboxSnapshot& B, float Alpha);
+};
+
+/**
+ * Ring buffer with the last hitbox snapshots of a character, sized once when the character is registered.
+ */
+struct FHitboxHistory
+{
+	// Allocates the snapshots, forgetting the recorded ones
+	void Init(int32 InCapacity);
+
+	void Push(const FHitboxSnapshot& Snapshot);
+
+	/**
+	 * Finds the state of the hitboxes at a past time, interpolating the two closest snapshots.
+	 * Times outside the history are clamped to the oldest or newest snapshot.
+	 *
+	 * @return False if there are no snapshots.
+	 */
+	bool Rewind(double Time, FHitboxSnapshot& OutSnapshot) const;
+
+	void Reset() { Head = 0; Num = 0; }
+
+private:
+	// Returns the snapshot at an index, 0 being the oldest
+	FORCEINLINE const FHitboxSnapshot& Get(const int32 Index) const { return Snapshots[(Head + Snapshots.Num() - Num + Index) % Snapshots.Num()]; }
+
+	TArray<FHitboxSnapshot> Snapshots;
+	int32 Head = 0;
+	int32 Num = 0;
+};
+
+/**
+ * Server side lag compensation of the hits against characters.
+ * A hitbox snapshot of each registered character is recorded in its ring buffer at SnapshotRate, at most once per server tick.
+ * The shots of remote players are traced against the capsules rewound to the server time the shooter was
+ * seeing, so a client hits the characters where it saw them, even if they moved during the round trip.
+ * The memory per character is fixed and no allocations are done after the registration.
+ */
+UCLASS(config=Game)
+class RPG_GAME_API ULagCompensationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts recording the hitboxes of a character
+	void RegisterCharacter(ACharacter* Character);
+
+	// Stops recording the hitboxes of a character
+	void UnregisterCharacter(ACharacter* Character);
+
+	/**
+	 * Traces a segment against the capsules of the registered characters rewound to a past server time.
+	 * Only reads the recorded history, so it can run on the tracing threads while the game thread waits for them.
+	 *
+	 * @param Time Server time when the shot was fired, as seen by the shooter.
+	 * @param Start Start of the segment.
+	 * @param End End of the segment.
+	 * @param IgnoredActor Actor never hit, usually the shooter.
+	 * @param OutHit The nearest hit, on the capsule of the character, at its rewound location.
+	 * @return True if a character was hit.
+	 */
+	bool TraceRewound(double Time, const FVector& Start, const FVector& End, const AActor* IgnoredActor, FHitResult& OutHit) const;
+
+	// Adds the registered characters to a list, the scene traces of the rewound shots ignore them
+	void GetCompensatedActors(TArray<AActor*>& OutActors) const;
+
+	// Maximum time the hitboxes can be rewound
+	UPROPERTY(Config)
+	float MaxRewindTime = 0.5f;
+
+	// Snapshots recorded per second, a server ticking faster records at this rate so the history covers MaxRewindTime
+	UPROPERTY(Config)
+	float SnapshotRate = 60.0f;
+
+	// Number of characters the subsystem reserves memory for
+	UPROPERTY(Config)
+	int32 ExpectedCharacters = 64;
+
+private:
+	struct FTrackedCharacter
+	{
+		TWeakObjectPtr<ACharacter> Character;
+		FHitboxHistory History;
+	};
+
+	// Records the current hitbox of a character
+	void RecordSnapshot(FTrackedCharacter& Tracked, double Time) const;
+
+	// Finds a registered character
+	const FTrackedCharacter* FindTracked(const ACharacter* Character) const;
+
+	TArray<FTrackedCharacter> TrackedCharacters;
+
+	// Snapshots kept per character, enough for MaxRewindTime at SnapshotRate
+	int32 HistoryCapacity = 0;
+
+	// Server time of the last recorded snapshots
+	double LastSnapshotTime = -UE_BIG_NUMBER;
+};
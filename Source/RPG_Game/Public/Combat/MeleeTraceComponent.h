@@ -0,0 +1,158 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "MeleeTraceComponent.generated.h"
+
+class UAnimMontage;
+class UMeshComponent;
+class USkeletalMeshComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMeleeHit, AActor*, HitActor, const FHitResult&, Hit);
+
+/**
+ * Traces the blade of a melee weapon during a swing.
+ * Every frame the blade, defined by a base and a tip socket, is sampled at sub-steps between the previous
+ * and the current frame, and an oriented capsule is swept between consecutive samples. When the swing comes
+ * from a montage on the traced skeletal mesh, the sub-steps evaluate the montage animation, so fast arcs are
+ * followed even at low tick rates. Otherwise the socket transforms are interpolated.
+ * Every actor is hit once per swing. The hits are resolved on the authority only.
+ */
+UCLASS(Blueprintable, BlueprintType, ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class RPG_GAME_API UMeleeTraceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UMeleeTraceComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * Sets the mesh holding the blade sockets. By default the first skeletal mesh of the owner is used.
+	 *
+	 * @param InMesh The mesh with the base and tip sockets.
+	 */
+	UFUNCTION(BlueprintCallable, Category=Melee)
+	void SetTracedMesh(UMeshComponent* InMesh);
+
+	/** Starts tracing a swing, forgetting the actors hit by the previous one */
+	UFUNCTION(BlueprintCallable, Category=Melee)
+	void BeginSwing();
+
+	/** Stops tracing the current swing */
+	UFUNCTION(BlueprintCallable, Category=Melee)
+	void EndSwing();
+
+	UFUNCTION(BlueprintPure, Category=Melee)
+	FORCEINLINE bool IsSwinging() const { return bSwinging; }
+
+	/** Socket or bone at the base of the blade */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee)
+	FName BaseSocketName = TEXT("blade_base");
+
+	/** Socket or bone at the tip of the blade */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee)
+	FName TipSocketName = TEXT("blade_tip");
+
+	/** Radius of the capsule around the blade */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "0.0"))
+	float TraceRadius = 8.0f;
+
+	/** Samples of the blade per second of animation. The sweeps per second stay the same at any tick rate */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "1.0"))
+	float SamplesPerSecond = 120.0f;
+
+	/** Maximum number of sub-steps in a single frame, to bound the cost of a long hitch */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "1"))
+	int32 MaxSubSteps = 16;
+
+	/** Maximum number of actors hit by a single swing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "1", ClampMax = "8"))
+	int32 MaxHitsPerSwing = 8;
+
+	/** Damage dealt to every actor hit by a swing */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "0.0"))
+	float Damage = 25.0f;
+
+	/** Speed of the equivalent projectile, used to compute the impulse applied to physics objects */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee, meta=(ClampMin = "0.0"))
+	float ImpulseSpeed = 1000.0f;
+
+	/** Collision channel of the sweeps */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Melee)
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Pawn;
+
+	/** Called on the authority the first time the swing hits an actor */
+	UPROPERTY(BlueprintAssignable, Category=Melee)
+	FOnMeleeHit OnMeleeHit;
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	// Bones from a socket to the root of the skeleton, to evaluate its position in a pose of an animation
+	struct FSocketBoneChain
+	{
+		// Skeleton bone indices from the socket bone to the root
+		TArray<int32, TInlineAllocator<16>> SkeletonBoneIndices;
+
+		// Reference pose of the bones missing in the skeleton of the animation
+		TArray<FTransform, TInlineAllocator<16>> RefPose;
+
+		FTransform SocketLocalTransform = FTransform::Identity;
+	};
+
+	// Position of the blade at an instant of the swing
+	struct FBladeSample
+	{
+		FVector Base = FVector::ZeroVector;
+		FVector Tip = FVector::ZeroVector;
+	};
+
+	// Returns the current blade in world space
+	FBladeSample GetCurrentBlade() const;
+
+	// Caches the bone chains of the sockets for the montage evaluation. Returns false if they can't be evaluated
+	bool BuildBoneChain(FName SocketName, const UAnimSequenceBase* Animation, FSocketBoneChain& OutChain) const;
+
+	/**
+	 * Evaluates the blade in component space at a position of the montage.
+	 *
+	 * @return False if the montage has no animation sequence at that position.
+	 */
+	bool SampleMontageBlade(const UAnimMontage* Montage, float MontagePosition, FBladeSample& OutSample);
+
+	// Sweeps the blade between two samples and handles the new hits
+	void SweepBlade(const FBladeSample& From, const FBladeSample& To);
+
+	void HandleHit(const FHitResult& Hit, const FVector& Velocity);
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMeshComponent> TracedMesh;
+
+	// Montage evaluated at the sub-steps and its position at the previous frame
+	TWeakObjectPtr<const UAnimMontage> SampledMontage;
+	float PreviousMontagePosition = 0.0f;
+
+	// Animation the bone chains were built for, and whether its skeleton matches the traced mesh
+	TWeakObjectPtr<const UAnimSequenceBase> ChainAnimation;
+	bool bChainsValid = false;
+
+	FSocketBoneChain BaseChain;
+	FSocketBoneChain TipChain;
+
+	// World blade and component transform at the previous frame
+	FBladeSample PreviousBlade;
+	FTransform PreviousComponentTransform;
+
+	// Hits of a single sweep, kept to reuse its memory
+	TArray<FHitResult> SweepHits;
+
+	// Actors already hit by the current swing
+	TArray<TWeakObjectPtr<AActor>, TInlineAllocator<8>> SwingHitActors;
+
+	bool bSwinging = false;
+};
@@ -0,0 +1,81 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Core/RPGEnums.h"
+#include "ProjectileSignificanceSubsystem.generated.h"
+
+class ARPG_GameProjectile;
+
+/**
+ * Scores the live projectiles by their distance to the player viewers and lowers the simulation
+ * detail of the ones nobody is close to. Projectiles behind every viewer count as farther away.
+ * The scoring runs at a fixed rate and only the projectiles changing level are updated.
+ *
+ * On clients the viewers are the local players, on the server every player controller, so the
+ * server keeps simulating the projectiles near any player at full detail.
+ */
+UCLASS(config=Game)
+class RPG_GAME_API UProjectileSignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Starts scoring a projectile, called when it begins play
+	void RegisterProjectile(ARPG_GameProjectile* Projectile);
+
+	// Stops scoring a projectile, called when it ends play
+	void UnregisterProjectile(ARPG_GameProjectile* Projectile);
+
+	FORCEINLINE int32 GetNumProjectiles() const { return Projectiles.Num(); }
+
+	// Returns the number of projectiles at a significance level on the last update
+	FORCEINLINE int32 GetNumProjectiles(EProjectileSignificance Significance) const { return SignificanceCounts[static_cast<int32>(Significance)]; }
+
+	// Distance to the closest viewer from which the projectiles drop to Medium
+	UPROPERTY(Config)
+	float MediumDistance = 3000.0f;
+
+	// Distance to the closest viewer from which the projectiles drop to Low
+	UPROPERTY(Config)
+	float LowDistance = 8000.0f;
+
+	// Multiplier of the distance of the projectiles behind a viewer
+	UPROPERTY(Config)
+	float BehindViewerDistanceScale = 2.0f;
+
+	// Seconds between movement updates of the Medium and Low projectiles
+	UPROPERTY(Config)
+	float MediumTickInterval = 1.0f / 30.0f;
+
+	UPROPERTY(Config)
+	float LowTickInterval = 0.1f;
+
+private:
+	// Scores every projectile and applies the changes of level
+	void UpdateSignificance();
+
+	// Puts every projectile back to High, used when the system is disabled
+	void RestoreAll();
+
+	EProjectileSignificance ComputeSignificance(const FVector& Location, TConstArrayView<FTransform> Viewers) const;
+
+	float GetTickInterval(EProjectileSignificance Significance) const;
+
+	UPROPERTY()
+	TArray<TObjectPtr<ARPG_GameProjectile>> Projectiles;
+
+	TStaticArray<int32, 3> SignificanceCounts{ InPlace, 0 };
+
+	// Time accumulated since the last update
+	float TimeSinceLastUpdate = 0.0f;
+
+	// True while any projectile is below High
+	bool bHasReducedProjectiles = false;
+};
@@ -0,0 +1,51 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Schedules the shots of a weapon at a fixed rate of fire, independent from the frame rate.
+ * Every frame the scheduler is advanced by the frame time and outputs how many shots were fired
+ * during the frame, with the time of each shot as a fraction of the frame.
+ */
+struct RPG_GAME_API FWeaponFireScheduler
+{
+public:
+	// Upper limit of shots in a single frame, to avoid bursts after a hitch
+	static constexpr int32 MaxShotsPerFrame = 32;
+
+	/**
+	 * Sets the rate of fire.
+	 *
+	 * @param RoundsPerMinute Shots per minute while the trigger is held.
+	 * @param bInAutomatic If false only one shot is fired every time the trigger is pulled.
+	 */
+	void Configure(float RoundsPerMinute, bool bInAutomatic);
+
+	// Pulls the trigger
+	void StartFiring();
+
+	// Releases the trigger
+	void StopFiring();
+
+	FORCEINLINE bool IsFiring() const { return bTriggerHeld; }
+
+	// Checks if the scheduler needs to be advanced, while firing or while the weapon is cooling down
+	FORCEINLINE bool IsActive() const { return bTriggerHeld || TimeUntilNextShot > 0.0f; }
+
+	/**
+	 * Advances the time of the scheduler.
+	 *
+	 * @param DeltaTime Time of the frame in seconds.
+	 * @param OutShotAlphas Time of every shot fired during the frame, 0 at the start of the frame and 1 at the end.
+	 * @return The number of shots fired during the frame.
+	 */
+	int32 Advance(float DeltaTime, TArray<float, TInlineAllocator<8>>& OutShotAlphas);
+
+private:
+	float ShotInterval = 0.1f;
+	float TimeUntilNextShot = 0.0f;
+	bool bAutomatic = true;
+	bool bTriggerHeld = false;
+};
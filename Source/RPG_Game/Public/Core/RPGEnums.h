@@ -9,4 +9,45 @@ enum class EMeshType : uint8
 {
 	StaticMesh UMETA(DisplayName = "Static Mesh"),
 	SkeletalMesh UMETA(DisplayName = "Skeletal Mesh")
+};
+
+//Define how a weapon resolves its shots
+UENUM(BlueprintType)
+enum class EWeaponFireMode : uint8
+{
+	Projectile UMETA(DisplayName = "Projectile"),
+	Hitscan UMETA(DisplayName = "Hitscan")
+};
+
+//Define how much detail a projectile simulates, from the full simulation to the cheapest one
+UENUM(BlueprintType)
+enum class EProjectileSignificance : uint8
+{
+	High UMETA(DisplayName = "High"),
+	Medium UMETA(DisplayName = "Medium"),
+	Low UMETA(DisplayName = "Low")
+};
+
+//Define what dealt a damage
+UENUM(BlueprintType)
+enum class EDamageSource : uint8
+{
+	Projectile UMETA(DisplayName = "Projectile"),
+	Hitscan UMETA(DisplayName = "Hitscan"),
+	Melee UMETA(DisplayName = "Melee")
+};
+
+//Define the slots where an item can be equipped
+UENUM(BlueprintType)
+enum class EEquipmentSlot : uint8
+{
+	None UMETA(DisplayName = "None"),
+	Head UMETA(DisplayName = "Head"),
+	Chest UMETA(DisplayName = "Chest"),
+	Hands UMETA(DisplayName = "Hands"),
+	Legs UMETA(DisplayName = "Legs"),
+	Feet UMETA(DisplayName = "Feet"),
+	MainHand UMETA(DisplayName = "Main Hand"),
+	OffHand UMETA(DisplayName = "Off Hand"),
+	Num UMETA(Hidden)
 };
\ No newline at end of file
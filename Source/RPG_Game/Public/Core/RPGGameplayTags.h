@@ -0,0 +1,12 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "NativeGameplayTags.h"
+
+// Gameplay tags used from the code, registered when the module is loaded
+namespace RPGGameplayTags
+{
+	// Magnitude of the damage set on the damage effect specs
+	RPG_GAME_API UE_DECLARE_GAMEPLAY_TAG_EXTERN(SetByCaller_Damage);
+}
@@ -25,4 +25,20 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TObjectPtr<USkeletalMesh> SkeletalMesh;
+
+	// Maximum amount of this item stored in a single inventory entry
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin = "1", ClampMax = "32767"))
+	int32 MaxStackSize = 1;
+
+	// Durability of a new item, 0 if the item doesn't wear out
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(ClampMin = "0", ClampMax = "65535"))
+	int32 MaxDurability = 0;
+
+	// Slot where the item is equipped, None if it can't be equipped
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EEquipmentSlot EquipmentSlot = EEquipmentSlot::None;
+
+	// Mesh worn by the character when the item is equipped, skinned to the skeleton of the character
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta=(EditCondition = "EquipmentSlot != EEquipmentSlot::None"))
+	TSoftObjectPtr<USkeletalMesh> EquippedMesh;
 };
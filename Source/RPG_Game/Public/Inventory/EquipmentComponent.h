@@ -0,0 +1,163 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/DataTable.h"
+#include "Core/RPGStructs.h"
+#include "EquipmentComponent.generated.h"
+
+class USkeletalMesh;
+class USkeletalMeshComponent;
+struct FStreamableHandle;
+
+/**
+ * Declares a multicast delegate broadcast every time the equipped meshes are updated.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnEquipmentChanged);
+
+/**
+ * Stores the items equipped by a character in fixed slots and builds their visuals.
+ * The armor pieces are merged with the body into a single skeletal mesh, so the character keeps one
+ * skinned component and its draw calls no matter how many pieces it wears. The weapons stay as separate
+ * components attached to the hand sockets, so they can be swapped and animated on their own.
+ *
+ * The meshes are loaded asynchronously and the changes of a frame are applied together, once loaded within the
+ * frame budget of the UEquipmentStreamingSubsystem. A new combination of pieces is merged later in its own
+ * frame budget, the pieces are shown as separate components meanwhile. Characters wearing
+ * the same pieces share the merged mesh. The merge needs CPU access to the source meshes, so the equipped
+ * meshes must be imported with it. The visuals are never built on dedicated servers.
+ */
+UCLASS( ClassGroup=(Inventory), Blueprintable, meta=(BlueprintSpawnableComponent) )
+class RPG_GAME_API UEquipmentComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEquipmentComponent();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	// DataTable storing the FItemStruct rows of the equipped items
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	UDataTable* ItemDataTable;
+
+	// Body mesh merged with the armor pieces. The skeletal mesh of the body component if not set
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	TObjectPtr<USkeletalMesh> BaseMesh;
+
+	// Sockets of the body where the weapons are attached
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	FName MainHandSocket = TEXT("hand_r");
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	FName OffHandSocket = TEXT("hand_l");
+
+	// If false every armor piece is a separate skeletal component following the body, like the weapons
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Setup")
+	bool bMergeArmorMeshes = true;
+
+	/** Delegate to broadcast when the equipped meshes are updated */
+	UPROPERTY(BlueprintAssignable, Category = "Equipment")
+	FOnEquipmentChanged OnEquipmentChanged;
+
+	/**
+	 * Equips an item in the slot of its row, replacing the item in that slot.
+	 * If the owner has an inventory, the item must be stored in it.
+	 *
+	 * @param ItemId Row name of the item in the ItemDataTable.
+	 * @return True if the item was equipped.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment")
+	bool EquipItem(FName ItemId);
+
+	/**
+	 * Removes the item of a slot.
+	 *
+	 * @param Slot The slot to empty.
+	 * @return The item removed, None if the slot was empty.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Equipment")
+	FName UnequipSlot(EEquipmentSlot Slot);
+
+	// Returns the item equipped in a slot, None if the slot is empty
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	FName GetEquippedItem(EEquipmentSlot Slot) const;
+
+	/**
+	 * Sets the skeletal component of the body. By default the first skeletal mesh component of the owner is used.
+	 *
+	 * @param InBodyMesh Component receiving the merged mesh, and parent of the weapons and the separate armor pieces.
+	 */
+	void SetBodyMeshComponent(USkeletalMeshComponent* InBodyMesh);
+
+	// Returns the number of skinned components used by the equipment, the body included
+	int32 GetNumSkinnedComponents() const;
+
+	// Returns true if the items of the slot are attached instead of merged
+	static bool IsWeaponSlot(EEquipmentSlot Slot) { return Slot == EEquipmentSlot::MainHand || Slot == EEquipmentSlot::OffHand; }
+
+protected:
+	virtual void BeginPlay() override;
+
+	UFUNCTION()
+	void OnRep_EquippedItems();
+
+	// Item of every slot, indexed by EEquipmentSlot. The size never changes
+	UPROPERTY(ReplicatedUsing = OnRep_EquippedItems)
+	TArray<FName> EquippedItems;
+
+private:
+	// Marks the visuals to be rebuilt, once for all the changes of the frame
+	void RequestVisualsUpdate();
+
+	// Loads the meshes of the equipped items and applies them
+	void LoadEquippedMeshes();
+
+	// Builds the weapon and armor components from the loaded meshes
+	void ApplyEquippedMeshes();
+
+	// Applies the meshes of a load request if no newer one was made
+	void ApplyLoadedMeshes(uint32 Serial);
+
+	// Merges the armor pieces of a load request if no newer one was made, then applies the merged mesh
+	void MergeLoadedMeshes(uint32 Serial);
+
+	// Gathers the loaded meshes of the equipped armor pieces, in slot order
+	void GetArmorMeshes(TArray<USkeletalMesh*>& OutArmorMeshes) const;
+
+	// Returns the merge of the body with the armor pieces if a character wearing the same pieces already built it
+	USkeletalMesh* FindMergedMesh(const TArray<USkeletalMesh*>& ArmorMeshes) const;
+
+	// Merges the body with the armor pieces, and shares the result with the characters wearing the same pieces
+	USkeletalMesh* MergeMeshes(const TArray<USkeletalMesh*>& ArmorMeshes) const;
+
+	// Creates a skeletal component attached to the body, or reuses the existing one
+	USkeletalMeshComponent* EnsurePieceComponent(TObjectPtr<USkeletalMeshComponent>& Component, FName Socket) const;
+
+	// Finds the data of an item in the ItemDataTable
+	const FItemStruct* FindItemData(FName ItemId) const;
+
+	// Checks if the owner has authority to modify the equipment and logs otherwise
+	bool CheckAuthority() const;
+
+	UPROPERTY(Transient)
+	TObjectPtr<USkeletalMeshComponent> BodyMesh;
+
+	// Components of the weapons and, when they are not merged, of the armor pieces. Indexed by EEquipmentSlot
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<USkeletalMeshComponent>> PieceComponents;
+
+	// Keeps the equipped meshes loaded
+	TSharedPtr<FStreamableHandle> LoadHandle;
+
+	// Incremented on every load, so only the last request is applied
+	uint32 LoadSerial = 0;
+
+	// Load request whose pieces failed to merge, they stay separate components
+	uint32 FailedMergeSerial = 0;
+
+	friend class UEquipmentStreamingSubsystem;
+};
@@ -0,0 +1,65 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameThreadResultSink.h"
+#include "EquipmentStreamingSubsystem.generated.h"
+
+class UEquipmentComponent;
+
+// Meshes of an equipment done loading, waiting to be applied or merged
+struct FEquipmentLoadResult
+{
+	TWeakObjectPtr<UEquipmentComponent> Equipment;
+
+	// Load request of the equipment the meshes belong to
+	uint32 Serial = 0;
+};
+
+/**
+ * Applies the equipment meshes once their asynchronous load is done.
+ * The loads complete in the middle of the streaming update, and applying them there can merge many meshes
+ * in one frame when a crowd spawns. The completed loads are queued instead, and applied in TG_PostUpdateWork
+ * within a time budget per frame, the rest on the next frames.
+ * The merges of the armor pieces can't leave the game thread, they create the mesh and its render resources,
+ * so they are queued the same way in their own budget.
+ */
+UCLASS()
+class RPG_GAME_API UEquipmentStreamingSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Queues the loaded meshes of an equipment to be applied.
+	 *
+	 * @param Equipment The equipment.
+	 * @param Serial Load request the meshes were loaded for.
+	 * @return False if they can't be queued, the caller must apply them itself.
+	 */
+	bool QueueLoadedMeshes(UEquipmentComponent* Equipment, uint32 Serial);
+
+	/**
+	 * Queues the merge of the armor pieces of an equipment.
+	 *
+	 * @param Equipment The equipment.
+	 * @param Serial Load request the pieces were loaded for.
+	 * @return False if it can't be queued, the caller must merge them itself.
+	 */
+	bool QueueMerge(UEquipmentComponent* Equipment, uint32 Serial);
+
+	// Returns the number of equipments waiting to be applied or merged
+	FORCEINLINE int32 GetNumPending() const
+	{
+		return (LoadedMeshes ? LoadedMeshes->GetNumPending() : 0) + (PendingMerges ? PendingMerges->GetNumPending() : 0);
+	}
+
+private:
+	TUniquePtr<TGameThreadResultSink<FEquipmentLoadResult>> LoadedMeshes;
+	TUniquePtr<TGameThreadResultSink<FEquipmentLoadResult>> PendingMerges;
+};
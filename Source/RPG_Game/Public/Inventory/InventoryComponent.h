@@ -0,0 +1,118 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/DataTable.h"
+#include "Core/RPGStructs.h"
+#include "Inventory/InventoryTypes.h"
+#include "InventoryComponent.generated.h"
+
+class ABaseItem;
+
+/**
+ * Declares a multicast delegate broadcast every time the content of the inventory changes,
+ * on the server when an operation is done and on the clients when the changes are replicated.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnInventoryChanged);
+
+/**
+ * Stores the items of an actor as compact value records in a flat array.
+ * Picked up items are converted into entries and the world actor is removed.
+ * All the operations are server authoritative, the entries are replicated by delta to the clients.
+ */
+UCLASS( ClassGroup=(Inventory), Blueprintable, meta=(BlueprintSpawnableComponent) )
+class RPG_GAME_API UInventoryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryComponent();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// DataTable storing the FItemStruct rows referenced by the entries
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	UDataTable* ItemDataTable;
+
+	// Class of the item actors placed in the world when an item is dropped
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	TSubclassOf<ABaseItem> DroppedItemClass;
+
+	// Maximum number of entries in the inventory
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup", meta=(ClampMin = "1", UIMin = "1"))
+	int32 MaxEntries = 32;
+
+	/** Delegate to broadcast when the content of the inventory changes */
+	UPROPERTY(BlueprintAssignable, Category = "Inventory")
+	FOnInventoryChanged OnInventoryChanged;
+
+	/**
+	 * Adds items to the inventory, filling the existing stacks first.
+	 *
+	 * @param ItemId Row name of the item in the ItemDataTable.
+	 * @param Count Amount of items to add.
+	 * @param Durability Durability of the added items. A negative value uses the MaxDurability of the row.
+	 * @return The amount of items that didn't fit in the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	int32 AddItem(FName ItemId, int32 Count = 1, int32 Durability = -1);
+
+	/**
+	 * Removes items from the inventory, starting from the last stacks.
+	 *
+	 * @param ItemId Row name of the item in the ItemDataTable.
+	 * @param Count Amount of items to remove.
+	 * @return The amount of items removed.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	int32 RemoveItem(FName ItemId, int32 Count = 1);
+
+	/**
+	 * Stores a world item in the inventory and returns the item actor to the item pool.
+	 *
+	 * @param Item The item actor to pick up.
+	 * @return True if the whole item fit in the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	bool PickUpItem(ABaseItem* Item);
+
+	/**
+	 * Removes one item from the inventory and places it in the world, reusing a pooled item actor if possible.
+	 *
+	 * @param ItemId Row name of the item in the ItemDataTable.
+	 * @param Transform Transform of the dropped item in the world.
+	 * @return The item actor placed in the world, or nullptr if the item wasn't in the inventory.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "Inventory")
+	ABaseItem* DropItem(FName ItemId, const FTransform& Transform);
+
+	// Returns the total amount of the item stored in the inventory
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetItemCount(FName ItemId) const;
+
+	// Returns the number of entries used in the inventory
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	FORCEINLINE int32 GetNumEntries() const { return Inventory.Entries.Num(); }
+
+	// Returns all the entries of the inventory
+	FORCEINLINE const TArray<FInventoryEntry>& GetEntries() const { return Inventory.Entries; }
+
+	// Called by the entries replication callbacks
+	void NotifyInventoryChanged();
+
+protected:
+	// Called when the game starts
+	virtual void BeginPlay() override;
+
+	UPROPERTY(Replicated)
+	FInventoryList Inventory;
+
+private:
+	// Finds the data of an item in the ItemDataTable
+	const FItemStruct* FindItemData(FName ItemId) const;
+
+	// Checks if the owner has authority to modify the inventory and logs otherwise
+	bool CheckAuthority() const;
+};
@@ -0,0 +1,77 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "InventoryTypes.generated.h"
+
+class UInventoryComponent;
+
+/**
+ * Compact value record of an item stored in an inventory.
+ * Items in the inventory are not UObjects, only the row name of the item in the items DataTable,
+ * the amount stacked in this entry and the durability left.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+public:
+	FInventoryEntry() = default;
+
+	FInventoryEntry(const FName InItemId, const int16 InStackCount, const uint16 InDurability)
+		: ItemId(InItemId), StackCount(InStackCount), Durability(InDurability)
+	{
+	}
+
+	// Row name of the item in the items DataTable
+	UPROPERTY(BlueprintReadOnly, Category="Inventory")
+	FName ItemId;
+
+	// Amount of items stacked in this entry
+	UPROPERTY()
+	int16 StackCount = 0;
+
+	// Durability left of the items in this entry, 0 if the item doesn't wear out
+	UPROPERTY()
+	uint16 Durability = 0;
+
+	// Replication callbacks, used to notify the owning component on clients
+	void PostReplicatedAdd(const struct FInventoryList& InArraySerializer);
+	void PostReplicatedChange(const struct FInventoryList& InArraySerializer);
+	void PreReplicatedRemove(const struct FInventoryList& InArraySerializer);
+};
+
+/**
+ * Flat array of inventory entries replicated by delta.
+ * Only the entries marked as dirty are sent to the clients.
+ */
+USTRUCT(BlueprintType)
+struct FInventoryList : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	TArray<FInventoryEntry> Entries;
+
+	// Component owning this list, not replicated
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UInventoryComponent> OwnerComponent;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FInventoryEntry, FInventoryList>(Entries, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventoryList> : public TStructOpsTypeTraitsBase2<FInventoryList>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -8,7 +8,8 @@
 #include "Core/RPGStructs.h"
 #include "BaseItem.generated.h"
 
-UCLASS()
+// ChildCanTick lets the Blueprints implementing the Tick event tick, the native item never does
+UCLASS(meta=(ChildCanTick))
 class RPG_GAME_API ABaseItem : public AActor
 {
 	GENERATED_BODY()
@@ -20,16 +21,51 @@ public:
 	// Called whenever the actor is updated in the editor or during spawning
 	virtual void OnConstruction(const FTransform& Transform) override;
 
+	// Returns the DataTable storing the item data
+	FORCEINLINE UDataTable* GetItemDataTable() const { return ItemDataTable; }
+
+	// Returns the name of the row of this item in the DataTable
+	FORCEINLINE FName GetRowName() const { return RowName; }
+
+	/**
+	 * Changes the DataTable row represented by this item without running the construction again.
+	 * The meshes are only updated if the row is different from the one already applied.
+	 *
+	 * @param InItemDataTable DataTable storing the item data.
+	 * @param InRowName Name of the row in the DataTable.
+	 */
+	void RebindItem(UDataTable* InItemDataTable, FName InRowName);
+
+	/**
+	 * Moves the item in or out of the item pool.
+	 * Pooled items are hidden and have collision and tick disabled.
+	 *
+	 * @param bInPooled True to put the item in the pool, false to take it out.
+	 */
+	void SetPooled(bool bInPooled);
+
+	// Checks if the item is currently stored in the item pool
+	UFUNCTION(BlueprintPure, Category="Item")
+	FORCEINLINE bool IsPooled() const { return bPooled; }
+
+	// Unregisters the item from the DataTable change notifications
+	virtual void BeginDestroy() override;
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	// Initializes the item once when its DataTable and row were both received
+	virtual void PostRepNotifies() override;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
 	// Reference to the DataTable storing the item data
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing=OnRep_ItemRow, Category="Setup")
 	UDataTable* ItemDataTable;
 
 	// Name of the row in the DataTable to query
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Setup")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, ReplicatedUsing=OnRep_ItemRow, Category="Setup")
 	FName RowName;
 
 	// Mesh used by the item (it can be either StaticMesh or SkeletalMesh)
@@ -42,6 +78,50 @@ protected:
 private:
 	// Function to initialize the item
 	void ItemInitialization();
+
+	// Checks if the last applied DataTable, row and row revision are still the current ones
+	bool IsInitializationUpToDate() const;
+
+	// Forgets the last applied row so the next ItemInitialization runs again
+	void InvalidateInitialization();
+
+	// Called when the DataTable this item was initialized from has been modified
+	void HandleDataTableChanged(uint32 NewRevision);
+
+	// Records that the DataTable or the row was received from the server
+	UFUNCTION()
+	void OnRep_ItemRow();
+
+	// Applies the pooled state received from the server
+	UFUNCTION()
+	void OnRep_Pooled();
+
+	// Hides the item and disables its collision and tick while it is pooled
+	void ApplyPooled();
+
+	// Marks the replicated properties dirty and sends them once to the clients while the item stays dormant
+	void MarkItemDirty();
+
+	// DataTable, row and row revision used by the last successful ItemInitialization
+	UPROPERTY(Transient)
+	TObjectPtr<UDataTable> AppliedDataTable;
+
+	UPROPERTY(Transient)
+	FName AppliedRowName;
+
+	uint32 AppliedRevision = 0;
+
+	// Hash of the row fields used by ItemInitialization, to detect if a DataTable change affected this item
+	uint32 AppliedRowHash = 0;
+
+	// Set by OnRep_ItemRow, the DataTable and the row share it so PostRepNotifies initializes once
+	bool bItemRowReceived = false;
+
+	// True while the item is stored in the item pool
+	UPROPERTY(ReplicatedUsing=OnRep_Pooled)
+	bool bPooled = false;
+
+	friend struct FItemDataTableRegistry;
 	
 public:	
 	// Called every frame
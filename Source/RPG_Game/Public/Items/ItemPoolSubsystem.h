@@ -0,0 +1,68 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Items/BaseItem.h"
+#include "ItemPoolSubsystem.generated.h"
+
+// Pooled item actors of a single class
+USTRUCT()
+struct FItemPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<ABaseItem>> Items;
+};
+
+/**
+ * Keeps the item actors removed from the world to reuse them when an item is dropped again,
+ * instead of destroying and spawning new actors on every pickup and drop.
+ * The pool is kept per item class, pooled items stay hidden and without collision.
+ */
+UCLASS()
+class RPG_GAME_API UItemPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/**
+	 * Gets an item actor from the pool, or spawns a new one if the pool of the class is empty.
+	 *
+	 * @param ItemClass Class of the item actor.
+	 * @param ItemDataTable DataTable storing the item data.
+	 * @param RowName Name of the row of the item in the DataTable.
+	 * @param Transform Transform of the item in the world.
+	 * @return The item actor, or nullptr if it couldn't be spawned.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Item|Pool")
+	ABaseItem* AcquireItem(TSubclassOf<ABaseItem> ItemClass, UDataTable* ItemDataTable, FName RowName, const FTransform& Transform);
+
+	/**
+	 * Removes an item actor from the world and stores it in the pool.
+	 * The item is destroyed if the pool of its class is full.
+	 *
+	 * @param Item The item actor to release.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Item|Pool")
+	void ReleaseItem(ABaseItem* Item);
+
+	// Returns the number of items currently stored in the pool
+	UFUNCTION(BlueprintPure, Category = "Item|Pool")
+	FORCEINLINE int32 GetNumPooledItems() const { return NumPooledItems; }
+
+	// Returns the number of spawns avoided by reusing pooled items
+	UFUNCTION(BlueprintPure, Category = "Item|Pool")
+	FORCEINLINE int32 GetNumSpawnsAvoided() const { return NumSpawnsAvoided; }
+
+private:
+	UPROPERTY()
+	TMap<TSubclassOf<ABaseItem>, FItemPoolBucket> Pools;
+
+	int32 NumPooledItems = 0;
+	int32 NumSpawnsAvoided = 0;
+};
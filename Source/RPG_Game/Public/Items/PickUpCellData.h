@@ -0,0 +1,48 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "SpatialCellIndex.h"
+#include "PickUpCellData.generated.h"
+
+class URPG_GamePickUpComponent;
+class ULevel;
+
+/**
+ * Pickups of a level with their spatial index, built when the level is saved or cooked and stored in the
+ * level as asset user data. The UPickUpManagerSubsystem links the whole level when it streams in,
+ * instead of registering every pickup in its grid.
+ */
+UCLASS()
+class RPG_GAME_API UPickUpCellData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY()
+	FSpatialCellIndex Index;
+
+	// Pickups of the level, in the order of the index
+	UPROPERTY()
+	TArray<TObjectPtr<URPG_GamePickUpComponent>> Components;
+
+	// Scaled radius of every pickup, in the order of the index
+	UPROPERTY()
+	TArray<float> Radii;
+
+	// Biggest radius of the pickups, used to size the queries
+	UPROPERTY()
+	float MaxRadius = 0.0f;
+
+#if WITH_EDITOR
+	/**
+	 * Builds the cell data of a level from its pickups, or removes it if there is none.
+	 * The pickups get their index in the cell data, saved with them.
+	 *
+	 * @param Level The level being saved.
+	 */
+	static void BuildForLevel(ULevel* Level);
+#endif
+};
@@ -0,0 +1,102 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpatialHashGrid.h"
+#include "LinkedCellRegistry.h"
+#include "Items/PickUpCellData.h"
+#include "PickUpManagerSubsystem.generated.h"
+
+class URPG_GamePickUpComponent;
+class ULevel;
+
+/**
+ * Detects when player characters reach a pickup without using overlap events.
+ * The pickups are stored in a spatial grid, and at a configurable rate only the cells around each
+ * player character are checked with a distance test between the pickup spheres and the character capsule.
+ * The pickups moving after they registered update their location in the grid.
+ * The pickups of a level with cell data (see UPickUpCellData) are not registered one by one:
+ * the whole level is linked when its first pickup begins play, and unlinked when it is removed.
+ */
+UCLASS()
+class RPG_GAME_API UPickUpManagerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * Starts checking the distance from the players to a pickup.
+	 *
+	 * @param PickUp The pickup component.
+	 * @param Location World location of the pickup.
+	 */
+	void RegisterPickUp(URPG_GamePickUpComponent* PickUp, const FVector& Location);
+
+	/**
+	 * Stops checking a pickup.
+	 *
+	 * @param PickUp The pickup component.
+	 * @param Location World location used to register the pickup.
+	 */
+	void UnregisterPickUp(URPG_GamePickUpComponent* PickUp, const FVector& Location);
+
+	/**
+	 * Updates the location of a registered pickup.
+	 *
+	 * @param PickUp The pickup component.
+	 * @param OldLocation Location the pickup is registered at.
+	 * @param NewLocation Current location of the pickup.
+	 */
+	void MovePickUp(URPG_GamePickUpComponent* PickUp, const FVector& OldLocation, const FVector& NewLocation);
+
+	/**
+	 * Links the cell data of the level of a pickup, if it is not linked yet.
+	 *
+	 * @param Level The level of the pickup.
+	 * @param PickUp The pickup starting its detection.
+	 * @param CellEntryIndex Index of the pickup in the cell data of the level.
+	 * @return True if the pickup is in the linked cell data at its current location and doesn't need to be registered.
+	 */
+	bool LinkCell(ULevel* Level, const URPG_GamePickUpComponent* PickUp, int32 CellEntryIndex);
+
+	// Stops checking a pickup of the linked cell data of its level
+	void DetachFromCell(const ULevel* Level, int32 CellEntryIndex);
+
+	// Returns the number of pickups currently registered one by one
+	FORCEINLINE int32 GetNumPickUps() const { return PickUps.Num(); }
+
+	// Returns the number of levels whose cell data is linked
+	FORCEINLINE int32 GetNumLinkedCells() const { return LinkedCells.Num(); }
+
+	// Size of the cells of the grids, also used to build the cell data
+	static float GetCellSize();
+
+private:
+	// Checks every player character against the pickups around it
+	void CheckPickUps();
+
+	struct FPickUpEntry
+	{
+		TWeakObjectPtr<URPG_GamePickUpComponent> Component;
+		float Radius = 0.0f;
+
+		bool operator==(const FPickUpEntry& Other) const { return Component == Other.Component; }
+	};
+
+	TSpatialHashGrid<FPickUpEntry> PickUps;
+
+	// Biggest radius of the registered pickups, used to size the grid queries
+	float MaxPickUpRadius = 0.0f;
+
+	// Time accumulated since the last check
+	float TimeSinceLastCheck = 0.0f;
+
+	TLinkedCellRegistry<UPickUpCellData> LinkedCells;
+};
@@ -0,0 +1,52 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BasicReplicationGraph.h"
+#include "UObject/ObjectKey.h"
+#include "RPGReplicationGraph.generated.h"
+
+/**
+ * Replication graph of the game. The world is divided in a 2D grid and every connection only considers the
+ * actors of the cells around its viewers, so the clients only receive the items and interactables near them.
+ *
+ * Items and interactables are dormant by default: they are routed through the dormancy aware path of the grid
+ * and cost nothing on the server until their state changes. The other spatialized actors are routed as dynamic.
+ *
+ * Enable it in DefaultEngine.ini:
+ * [/Script/OnlineSubsystemUtils.IpNetDriver]
+ * ReplicationDriverClassName="/Script/RPG_Game.RPGReplicationGraph"
+ */
+UCLASS(Transient, Config=Engine)
+class RPG_GAME_API URPGReplicationGraph : public UBasicReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	// Size of the cells of the grid
+	UPROPERTY(Config)
+	float GridCellSize = 10000.0f;
+
+	// Lowest corner of the grid, the actors below it are clamped to the first cells
+	UPROPERTY(Config)
+	FVector2D GridSpatialBias = FVector2D(-UE_OLD_WORLD_MAX, -UE_OLD_WORLD_MAX);
+
+	// Distance from a viewer where the items stop being relevant
+	UPROPERTY(Config)
+	float ItemCullDistance = 5000.0f;
+
+private:
+	// Checks if the actor has an interactable component sleeping by default, pawns and moving actors excluded.
+	// Items are not checked here: they replicate their movement and sleep through DORM_Initial only
+	static bool IsDormantByDefault(const AActor* Actor);
+
+	// Actors added to the grid through the dormancy path, they must be removed through it too
+	TSet<FObjectKey> DormancyRoutedActors;
+};
@@ -0,0 +1,110 @@
+// Copyright (c) 2025, Balbjorn Bran. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldStateSubsystem.generated.h"
+
+// Bits of the saved state of an actor placed in a level
+namespace EWorldActorStateFlags
+{
+	enum Type : uint8
+	{
+		None = 0,
+		PickedUp = 1 << 0,
+		Opened = 1 << 1,
+		Disabled = 1 << 2,
+	};
+
+	// Number of bits used to serialize the flags
+	constexpr int32 NumBits = 3;
+}
+
+/**
+ * Saved difference of an actor placed in a level from its level default.
+ * Actors back to their default are not stored.
+ */
+struct FWorldActorState
+{
+	uint8 Flags = EWorldActorStateFlags::None;
+
+	// Cooldown left when the state was saved, in tenths of second
+	uint16 CooldownDeciseconds = 0;
+
+	FORCEINLINE bool IsDefault() const { return Flags == EWorldActorStateFlags::None && CooldownDeciseconds == 0; }
+};
+
+/**
+ * Persists the changes done to the actors placed in the levels of the world: picked up items,
+ * opened or disabled interactables and their cooldowns.
+ * Only the differences from the level defaults are stored, keyed by a stable id built from the level and the
+ * actor name, and bit-packed in a binary file per map. The saved state is applied to every level actor in a
+ * single pass when the world begins play, before the actors do.
+ */
+UCLASS()
+class RPG_GAME_API UWorldStateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	/**
+	 * Returns the stable id of an actor placed in a level, the same across sessions and in PIE.
+	 *
+	 * @param Actor The actor.
+	 * @return The id, or 0 if the actor was spawned at runtime and can't be persisted.
+	 */
+	static uint64 GetStableId(const AActor* Actor);
+
+	// Records that an actor placed in a level has been picked up, so it is removed when the level is loaded again
+	void MarkPickedUp(const AActor* Actor);
+
+	// Captures the state of the level actors and writes it to the save file of the map
+	UFUNCTION(BlueprintCallable, Category = "Persistence")
+	bool SaveWorldState();
+
+	// Reads the save file of the map and applies it to the level actors
+	UFUNCTION(BlueprintCallable, Category = "Persistence")
+	bool LoadWorldState();
+
+	/**
+	 * Writes states in the binary format of the save files.
+	 *
+	 * @param States The states, keyed by stable id.
+	 * @param OutBytes The serialized states.
+	 */
+	static void WriteStates(const TMap<uint64, FWorldActorState>& States, TArray<uint8>& OutBytes);
+
+	/**
+	 * Reads states written by WriteStates.
+	 *
+	 * @param Bytes The serialized states.
+	 * @param OutStates The states read, keyed by stable id.
+	 * @return False if the data is not valid.
+	 */
+	static bool ReadStates(const TArray<uint8>& Bytes, TMap<uint64, FWorldActorState>& OutStates);
+
+	FORCEINLINE int32 GetNumStates() const { return States.Num(); }
+
+	// Durations of the last load, used to measure the cost of the persistence
+	FORCEINLINE double GetLastReadSeconds() const { return LastReadSeconds; }
+	FORCEINLINE double GetLastApplySeconds() const { return LastApplySeconds; }
+
+private:
+	// Applies the states to every actor of the loaded levels in a single pass
+	void ApplyStates();
+
+	// Updates the states from the current state of the interactables of the loaded levels
+	void CaptureStates();
+
+	// Returns the path of the save file of the map of the world
+	FString GetSaveFilePath() const;
+
+	TMap<uint64, FWorldActorState> States;
+
+	double LastReadSeconds = 0.0;
+	double LastApplySeconds = 0.0;
+};
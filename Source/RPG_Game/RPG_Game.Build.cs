@@ -9,7 +9,7 @@ public class RPG_Game : ModuleRules
 	{
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "GameplayTasks", "GameplayAbilities", "MetasoundEngine", "MotionCore", "GameplayTags"});
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "EnhancedInput", "GameplayTasks", "GameplayAbilities", "MetasoundEngine", "MotionCore", "GameplayTags", "NetCore", "GeneralLibrary", "FPP_Interaction", "Json", "ReplicationGraph"});
 
 		PublicIncludePaths.AddRange(
 			new string[] {
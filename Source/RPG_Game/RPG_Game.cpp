@@ -5,6 +5,7 @@
 
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, RPG_Game, "RPG_Game" );
 DEFINE_LOG_CATEGORY(ItemLog);
+DEFINE_LOG_CATEGORY(InventoryLog);
 DEFINE_LOG_CATEGORY(DetectionLog);
 DEFINE_LOG_CATEGORY(RPGLog);
  
\ No newline at end of file
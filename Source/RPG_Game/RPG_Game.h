@@ -3,12 +3,18 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Stats/Stats.h"
 
 //Log Categories
 DECLARE_LOG_CATEGORY_EXTERN(ItemLog, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(InventoryLog, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(DetectionLog, Log, All);
 DECLARE_LOG_CATEGORY_EXTERN(RPGLog, Log, All);
 
+//Stat Groups
+DECLARE_STATS_GROUP(TEXT("RPG Items"), STATGROUP_RPGItems, STATCAT_Advanced);
+DECLARE_STATS_GROUP(TEXT("RPG Combat"), STATGROUP_RPGCombat, STATCAT_Advanced);
+
 //DebugMacros
 #define RPG_PRINT_FUNC (FString(__FUNCTION__))
 #define RPG_PRINT_LINE (FString::FromInt(__LINE__))
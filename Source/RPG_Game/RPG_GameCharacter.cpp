@@ -2,6 +2,7 @@
 
 #include "RPG_GameCharacter.h"
 #include "RPG_GameProjectile.h"
+#include "RPG_GameWeaponComponent.h"
 #include "Animation/AnimInstance.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
@@ -10,6 +11,9 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputActionValue.h"
 #include "Engine/LocalPlayer.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Combat/LagCompensationSubsystem.h"
 
 DEFINE_LOG_CATEGORY(LogTemplateCharacter);
 
@@ -37,6 +41,57 @@ ARPG_GameCharacter::ARPG_GameCharacter()
 
 }
 
+void ARPG_GameCharacter::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Record the hitboxes on the server for the lag compensation
+	if (HasAuthority())
+	{
+		if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+	}
+}
+
+void ARPG_GameCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ULagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<ULagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+double ARPG_GameCharacter::GetViewedServerTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	if (GameState == nullptr)
+	{
+		return GetWorld()->GetTimeSeconds();
+	}
+
+	// The estimated server time is the present of the server, the other characters are seen as they were when sent
+	const APlayerState* State = GetPlayerState();
+	const double OneWayLatency = (State != nullptr && !HasAuthority()) ? State->ExactPing * 0.5 / 1000.0 : 0.0;
+	return GameState->GetServerWorldTimeSeconds() - OneWayLatency;
+}
+
+void ARPG_GameCharacter::ServerFireHitscan_Implementation(FVector_NetQuantize Start, FVector_NetQuantizeNormal Direction, double ClientServerTime)
+{
+	// The weapon is attached to the arms when picked up
+	for (USceneComponent* Child : Mesh1P->GetAttachChildren())
+	{
+		if (URPG_GameWeaponComponent* Weapon = Cast<URPG_GameWeaponComponent>(Child))
+		{
+			Weapon->QueueRemoteHitscanShot(Start, Direction, ClientServerTime);
+			return;
+		}
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////// Input
 
 void ARPG_GameCharacter::NotifyControllerChanged()
@@ -56,6 +56,11 @@ protected:
 	void Look(const FInputActionValue& Value);
 
 protected:
+	// AActor interface
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	// End of AActor interface
+
 	// APawn interface
 	virtual void NotifyControllerChanged() override;
 	virtual void SetupPlayerInputComponent(UInputComponent* InputComponent) override;
@@ -67,5 +72,18 @@ public:
 	/** Returns FirstPersonCameraComponent subobject **/
 	UCameraComponent* GetFirstPersonCameraComponent() const { return FirstPersonCameraComponent; }
 
+	/** Returns the server time of the world state this client is seeing, the replicated movement arriving half a round trip late */
+	double GetViewedServerTime() const;
+
+	/**
+	 * Fires a hitscan shot of the held weapon on the server, resolved against the world seen by the client.
+	 *
+	 * @param Start Start of the shot on the client.
+	 * @param Direction Direction of the shot, with the spread applied.
+	 * @param ClientServerTime Server time of the world the client was seeing when firing.
+	 */
+	UFUNCTION(Server, Unreliable)
+	void ServerFireHitscan(FVector_NetQuantize Start, FVector_NetQuantizeNormal Direction, double ClientServerTime);
+
 };
 
@@ -1,31 +1,137 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "RPG_GamePickUpComponent.h"
+#include "Items/PickUpManagerSubsystem.h"
 
 URPG_GamePickUpComponent::URPG_GamePickUpComponent()
 {
 	// Setup the Sphere Collision
 	SphereRadius = 32.f;
+
+	// The pickup manager checks the distance to the players, so by default the sphere doesn't need any collision
+	SetGenerateOverlapEvents(false);
+	SetCollisionEnabled(ECollisionEnabled::NoCollision);
 }
 
 void URPG_GamePickUpComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	StartPickUpDetection();
+}
+
+void URPG_GamePickUpComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopPickUpDetection();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void URPG_GamePickUpComponent::NotifyPickUp(ARPG_GameCharacter* Character)
+{
+	// Stop detecting first, so the delegate can safely destroy or pool the owner
+	StopPickUpDetection();
+
+	// Notify that the actor is being picked up
+	OnPickUp.Broadcast(Character);
+}
+
+void URPG_GamePickUpComponent::ResetPickUp()
+{
+	StopPickUpDetection();
+	StartPickUpDetection();
+}
+
+void URPG_GamePickUpComponent::StartPickUpDetection()
+{
+	if (bUsePickUpManager)
+	{
+		if (UPickUpManagerSubsystem* PickUpManager = GetWorld()->GetSubsystem<UPickUpManagerSubsystem>())
+		{
+			TransformUpdated.AddUObject(this, &URPG_GamePickUpComponent::HandleTransformUpdated);
+
+			// Pickups saved with the cell data of their level are already in the index, if they are still at their saved location.
+			// A pooled pickup moved while its detection was stopped didn't see the TransformUpdated, the link checks the location
+			if (CellEntryIndex != INDEX_NONE && !bMovedFromCell && PickUpManager->LinkCell(GetOwner()->GetLevel(), this, CellEntryIndex))
+			{
+				bLinkedToCell = true;
+				return;
+			}
+
+			RegisteredLocation = GetComponentLocation();
+			PickUpManager->RegisterPickUp(this, RegisteredLocation);
+			bRegisteredInManager = true;
+		}
+		return;
+	}
+
+	// Without the manager the sphere needs to generate overlaps again
+	SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SetGenerateOverlapEvents(true);
+
 	// Register our Overlap Event
 	OnComponentBeginOverlap.AddDynamic(this, &URPG_GamePickUpComponent::OnSphereBeginOverlap);
 }
 
+void URPG_GamePickUpComponent::StopPickUpDetection()
+{
+	if (bLinkedToCell)
+	{
+		if (UPickUpManagerSubsystem* PickUpManager = GetWorld()->GetSubsystem<UPickUpManagerSubsystem>())
+		{
+			PickUpManager->DetachFromCell(GetOwner()->GetLevel(), CellEntryIndex);
+		}
+		bLinkedToCell = false;
+	}
+
+	if (bRegisteredInManager)
+	{
+		if (UPickUpManagerSubsystem* PickUpManager = GetWorld()->GetSubsystem<UPickUpManagerSubsystem>())
+		{
+			PickUpManager->UnregisterPickUp(this, RegisteredLocation);
+		}
+		bRegisteredInManager = false;
+	}
+
+	TransformUpdated.RemoveAll(this);
+
+	// Unregister from the Overlap Event so it is no longer triggered
+	OnComponentBeginOverlap.RemoveAll(this);
+}
+
+void URPG_GamePickUpComponent::HandleTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UPickUpManagerSubsystem* PickUpManager = GetWorld()->GetSubsystem<UPickUpManagerSubsystem>();
+	if (!PickUpManager)
+	{
+		return;
+	}
+
+	const FVector Location = GetComponentLocation();
+	if (bLinkedToCell)
+	{
+		// The cell data only knows the saved location, a moved pickup is registered on its own
+		PickUpManager->DetachFromCell(GetOwner()->GetLevel(), CellEntryIndex);
+		bLinkedToCell = false;
+		bMovedFromCell = true;
+
+		RegisteredLocation = Location;
+		PickUpManager->RegisterPickUp(this, RegisteredLocation);
+		bRegisteredInManager = true;
+	}
+	else if (bRegisteredInManager && !Location.Equals(RegisteredLocation))
+	{
+		PickUpManager->MovePickUp(this, RegisteredLocation, Location);
+		RegisteredLocation = Location;
+	}
+}
+
 void URPG_GamePickUpComponent::OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
 	// Checking if it is a First Person Character overlapping
 	ARPG_GameCharacter* Character = Cast<ARPG_GameCharacter>(OtherActor);
 	if(Character != nullptr)
 	{
-		// Notify that the actor is being picked up
-		OnPickUp.Broadcast(Character);
-
-		// Unregister from the Overlap Event so it is no longer triggered
-		OnComponentBeginOverlap.RemoveAll(this);
+		NotifyPickUp(Character);
 	}
 }
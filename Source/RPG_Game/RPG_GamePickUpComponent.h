@@ -22,13 +22,55 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Interaction")
 	FOnPickUp OnPickUp;
 
+	/** If true, the pickup is detected by the UPickUpManagerSubsystem instead of overlap events */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Interaction")
+	bool bUsePickUpManager = true;
+
 	URPG_GamePickUpComponent();
+
+	/** Notifies that the character picked this up, and stops detecting new pickups */
+	void NotifyPickUp(ARPG_GameCharacter* Character);
+
+	/** Starts detecting pickups again, e.g. when the owner is reused from a pool */
+	UFUNCTION(BlueprintCallable, Category = "Interaction")
+	void ResetPickUp();
+
 protected:
 
 	/** Called when the game starts */
 	virtual void BeginPlay() override;
 
+	/** Called when the game ends or the component is destroyed */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/** Code for when something overlaps this component */
 	UFUNCTION()
 	void OnSphereBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-};
\ No newline at end of file
+
+private:
+	/** Starts detecting pickups, with the manager or with overlap events */
+	void StartPickUpDetection();
+
+	/** Stops detecting pickups */
+	void StopPickUpDetection();
+
+	/** Keeps the location known by the manager up to date when the pickup moves */
+	void HandleTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+
+	/** Location used to register in the manager */
+	FVector RegisteredLocation = FVector::ZeroVector;
+
+	bool bRegisteredInManager = false;
+
+	/** Index in the cell data of the level, set when the level is saved or cooked */
+	UPROPERTY()
+	int32 CellEntryIndex = INDEX_NONE;
+
+	/** True if the pickup is checked through the linked cell data of its level */
+	bool bLinkedToCell = false;
+
+	/** True once the pickup moved away from the location saved in the cell data */
+	bool bMovedFromCell = false;
+
+	friend class UPickUpCellData;
+};
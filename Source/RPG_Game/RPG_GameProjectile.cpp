@@ -3,6 +3,12 @@
 #include "RPG_GameProjectile.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Components/SphereComponent.h"
+#include "Components/AudioComponent.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Combat/ProjectileSignificanceSubsystem.h"
+#include "Combat/DamagePipelineSubsystem.h"
+#include "AbilitySystemGlobals.h"
+#include "GameplayPerfTracker.h"
 
 ARPG_GameProjectile::ARPG_GameProjectile() 
 {
@@ -31,13 +37,126 @@ ARPG_GameProjectile::ARPG_GameProjectile()
 	InitialLifeSpan = 3.0f;
 }
 
+void ARPG_GameProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	bDefaultShouldBounce = ProjectileMovement->bShouldBounce;
+	DefaultResponses = CollisionComp->GetCollisionResponseToChannels();
+
+	if (UProjectileSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UProjectileSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->RegisterProjectile(this);
+	}
+}
+
+void ARPG_GameProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UProjectileSignificanceSubsystem* SignificanceSubsystem = GetWorld()->GetSubsystem<UProjectileSignificanceSubsystem>())
+	{
+		SignificanceSubsystem->UnregisterProjectile(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARPG_GameProjectile::SetSignificance(EProjectileSignificance NewSignificance, float MovementTickInterval)
+{
+	ProjectileMovement->SetComponentTickInterval(MovementTickInterval);
+
+	if (NewSignificance == Significance)
+	{
+		return;
+	}
+
+	const bool bWasLow = Significance == EProjectileSignificance::Low;
+	const bool bIsLow = NewSignificance == EProjectileSignificance::Low;
+	Significance = NewSignificance;
+
+	if (bWasLow == bIsLow)
+	{
+		return;
+	}
+
+	SetPresentationCulled(bIsLow);
+
+	// The server simulation decides the hits, only the copies of the clients are simplified
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	ProjectileMovement->bShouldBounce = bIsLow ? false : bDefaultShouldBounce;
+
+	if (bIsLow)
+	{
+		// Only the world stops the projectile
+		FCollisionResponseContainer Responses(ECR_Ignore);
+		Responses.SetResponse(ECC_WorldStatic, DefaultResponses.GetResponse(ECC_WorldStatic));
+		Responses.SetResponse(ECC_WorldDynamic, DefaultResponses.GetResponse(ECC_WorldDynamic));
+		CollisionComp->SetCollisionResponseToChannels(Responses);
+	}
+	else
+	{
+		CollisionComp->SetCollisionResponseToChannels(DefaultResponses);
+	}
+}
+
+void ARPG_GameProjectile::SetPresentationCulled(bool bCulled)
+{
+	ForEachComponent<USceneComponent>(false, [this, bCulled](USceneComponent* Component)
+	{
+		if (Component == CollisionComp)
+		{
+			return;
+		}
+
+		if (UFXSystemComponent* FXComponent = Cast<UFXSystemComponent>(Component))
+		{
+			FXComponent->SetPaused(bCulled);
+			FXComponent->SetVisibility(!bCulled);
+		}
+		else if (UAudioComponent* AudioComponent = Cast<UAudioComponent>(Component))
+		{
+			AudioComponent->SetPaused(bCulled);
+		}
+		else if (Component->IsA<UPrimitiveComponent>())
+		{
+			Component->SetVisibility(!bCulled);
+		}
+	});
+}
+
 void ARPG_GameProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
 {
-	// Only add impulse and destroy projectile if we hit a physics
-	if ((OtherActor != nullptr) && (OtherActor != this) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
+	GENLIB_PERF_SCOPE("ProjectileHit");
+
+	// Actors with an ability system take the damage and stop the projectile
+	if (OtherActor && OtherActor != this && OtherActor != GetInstigator() && UAbilitySystemGlobals::GetAbilitySystemComponentFromActor(OtherActor))
 	{
-		OtherComp->AddImpulseAtLocation(GetVelocity() * 100.0f, GetActorLocation());
+		if (UDamagePipelineSubsystem* DamagePipeline = GetWorld()->GetSubsystem<UDamagePipelineSubsystem>())
+		{
+			DamagePipeline->EnqueueDamage({ OtherActor, GetInstigator(), Damage, EDamageSource::Projectile });
+		}
+		ApplyHitImpulse(this, OtherActor, OtherComp, GetVelocity(), GetActorLocation());
+		Destroy();
+		return;
+	}
 
+	// Only destroy projectile if we hit a physics
+	if (ApplyHitImpulse(this, OtherActor, OtherComp, GetVelocity(), GetActorLocation()))
+	{
 		Destroy();
 	}
+}
+
+bool ARPG_GameProjectile::ApplyHitImpulse(const AActor* Instigator, const AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& Velocity, const FVector& Location)
+{
+	// Only add impulse if we hit a physics
+	if ((OtherActor != nullptr) && (OtherActor != Instigator) && (OtherComp != nullptr) && OtherComp->IsSimulatingPhysics())
+	{
+		OtherComp->AddImpulseAtLocation(Velocity * 100.0f, Location);
+		return true;
+	}
+	return false;
 }
\ No newline at end of file
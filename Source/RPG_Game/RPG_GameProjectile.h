@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Core/RPGEnums.h"
 #include "RPG_GameProjectile.generated.h"
 
 class USphereComponent;
@@ -25,13 +26,51 @@ class ARPG_GameProjectile : public AActor
 public:
 	ARPG_GameProjectile();
 
+	/** Damage dealt to the actors with an ability system hit by the projectile */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category=Projectile, meta=(ClampMin = "0.0"))
+	float Damage = 10.0f;
+
 	/** called when projectile hits something */
 	UFUNCTION()
 	void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/** Adds the impulse of a shot to the hit component if it simulates physics. Returns true if the impulse was applied */
+	static bool ApplyHitImpulse(const AActor* Instigator, const AActor* OtherActor, UPrimitiveComponent* OtherComp, const FVector& Velocity, const FVector& Location);
+
+	/**
+	 * Changes the detail of the simulation. Medium and Low reduce the movement update rate, Low also
+	 * culls the visual and audio components. On clients Low also stops bouncing and ignores the secondary
+	 * collision channels, the server keeps its collision and bounces so the hits stay authoritative.
+	 *
+	 * @param NewSignificance The new significance level.
+	 * @param MovementTickInterval Seconds between movement updates, 0 updates every frame.
+	 */
+	void SetSignificance(EProjectileSignificance NewSignificance, float MovementTickInterval);
+
+	FORCEINLINE EProjectileSignificance GetSignificance() const { return Significance; }
+
 	/** Returns CollisionComp subobject **/
 	USphereComponent* GetCollisionComp() const { return CollisionComp; }
 	/** Returns ProjectileMovement subobject **/
 	UProjectileMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Hides or shows the visual and audio components of the projectile
+	void SetPresentationCulled(bool bCulled);
+
+	EProjectileSignificance Significance = EProjectileSignificance::High;
+
+	// Simulation settings of the High significance, restored when the projectile becomes significant again
+	bool bDefaultShouldBounce = true;
+	FCollisionResponseContainer DefaultResponses;
+
+	// Position in the significance subsystem, used to unregister in constant time
+	int32 SignificanceIndex = INDEX_NONE;
+
+	friend class UProjectileSignificanceSubsystem;
 };
 
@@ -2,8 +2,10 @@
 
 
 #include "RPG_GameWeaponComponent.h"
+#include "RPG_Game.h"
 #include "RPG_GameCharacter.h"
 #include "RPG_GameProjectile.h"
+#include "Combat/HitscanSubsystem.h"
 #include "GameFramework/PlayerController.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Kismet/GameplayStatics.h"
@@ -12,6 +14,14 @@
 #include "Animation/AnimInstance.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
+#include "GameplayPerfTracker.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+
+// Distance a remote shot may start past the muzzle offset, for the movement corrections between the client and the server
+static constexpr float RemoteMuzzleTolerance = 100.0f;
+
+// Remote shots accepted back to back, for the shots bunched together by the network jitter
+static constexpr double RemoteShotBurst = 3.0;
 
 // Sets default values for this component's properties
 URPG_GameWeaponComponent::URPG_GameWeaponComponent()
@@ -23,32 +33,137 @@ URPG_GameWeaponComponent::URPG_GameWeaponComponent()
 
 void URPG_GameWeaponComponent::Fire()
 {
-	if (Character == nullptr || Character->GetController() == nullptr)
+	FVector MuzzleLocation;
+	FRotator MuzzleRotation;
+	if (!GetMuzzleTransform(MuzzleLocation, MuzzleRotation))
+	{
+		return;
+	}
+
+	const FWeaponShot Shot = { MuzzleLocation, MuzzleRotation, 0.0f };
+	FireShots(MakeArrayView(&Shot, 1));
+}
+
+void URPG_GameWeaponComponent::StartFiring()
+{
+	// Start interpolating the shots from the current muzzle position
+	if (!FireScheduler.IsActive())
+	{
+		GetMuzzleTransform(PreviousMuzzleLocation, PreviousMuzzleRotation);
+	}
+
+	FireScheduler.Configure(RoundsPerMinute, bAutomatic);
+	FireScheduler.StartFiring();
+}
+
+void URPG_GameWeaponComponent::StopFiring()
+{
+	FireScheduler.StopFiring();
+}
+
+void URPG_GameWeaponComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!FireScheduler.IsActive())
+	{
+		return;
+	}
+
+	TArray<float, TInlineAllocator<8>> ShotAlphas;
+	const int32 NumShots = FireScheduler.Advance(DeltaTime, ShotAlphas);
+
+	// The muzzle is recorded every frame, so the shots are interpolated from the previous frame even when it didn't fire
+	FVector MuzzleLocation;
+	FRotator MuzzleRotation;
+	if (!GetMuzzleTransform(MuzzleLocation, MuzzleRotation))
+	{
+		return;
+	}
+	const FVector StartLocation = PreviousMuzzleLocation;
+	const FQuat StartRotation = PreviousMuzzleRotation.Quaternion();
+	PreviousMuzzleLocation = MuzzleLocation;
+	PreviousMuzzleRotation = MuzzleRotation;
+
+	if (NumShots == 0)
+	{
+		return;
+	}
+
+	// Every shot starts from the muzzle position at its own time inside the frame
+	TArray<FWeaponShot, TInlineAllocator<8>> Shots;
+	for (const float Alpha : ShotAlphas)
+	{
+		Shots.Add({
+			FMath::Lerp(StartLocation, MuzzleLocation, Alpha),
+			FQuat::Slerp(StartRotation, MuzzleRotation.Quaternion(), Alpha).Rotator(),
+			(1.0f - Alpha) * DeltaTime
+		});
+	}
+
+	FireShots(Shots);
+}
+
+bool URPG_GameWeaponComponent::GetMuzzleTransform(FVector& OutLocation, FRotator& OutRotation) const
+{
+	if (Character == nullptr)
+	{
+		return false;
+	}
+
+	const APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
+	if (PlayerController == nullptr || PlayerController->PlayerCameraManager == nullptr)
+	{
+		return false;
+	}
+
+	OutRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
+	// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
+	OutLocation = GetOwner()->GetActorLocation() + OutRotation.RotateVector(MuzzleOffset);
+	return true;
+}
+
+void URPG_GameWeaponComponent::FireShots(TArrayView<const FWeaponShot> Shots)
+{
+	GENLIB_PERF_SCOPE("WeaponFire");
+
+	UWorld* const World = GetWorld();
+	if (World == nullptr || Shots.IsEmpty())
 	{
 		return;
 	}
 
-	// Try and fire a projectile
-	if (ProjectileClass != nullptr)
+	// Try and fire hitscan shots, the subsystem resolves all the shots of the frame together
+	if (FireMode == EWeaponFireMode::Hitscan)
 	{
-		UWorld* const World = GetWorld();
-		if (World != nullptr)
+		for (const FWeaponShot& Shot : Shots)
+		{
+			QueueHitscanShot(Shot.Location, Shot.Rotation);
+		}
+	}
+	// Try and fire projectiles
+	else if (ProjectileClass != nullptr)
+	{
+		//Set Spawn Collision Handling Override
+		FActorSpawnParameters ActorSpawnParams;
+		ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
+		ActorSpawnParams.Instigator = Character;
+
+		for (const FWeaponShot& Shot : Shots)
 		{
-			APlayerController* PlayerController = Cast<APlayerController>(Character->GetController());
-			const FRotator SpawnRotation = PlayerController->PlayerCameraManager->GetCameraRotation();
-			// MuzzleOffset is in camera space, so transform it to world space before offsetting from the character location to find the final muzzle position
-			const FVector SpawnLocation = GetOwner()->GetActorLocation() + SpawnRotation.RotateVector(MuzzleOffset);
-	
-			//Set Spawn Collision Handling Override
-			FActorSpawnParameters ActorSpawnParams;
-			ActorSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButDontSpawnIfColliding;
-	
 			// Spawn the projectile at the muzzle
-			World->SpawnActor<ARPG_GameProjectile>(ProjectileClass, SpawnLocation, SpawnRotation, ActorSpawnParams);
+			ARPG_GameProjectile* Projectile = World->SpawnActor<ARPG_GameProjectile>(ProjectileClass, Shot.Location, Shot.Rotation, ActorSpawnParams);
+
+			// Move the projectile the distance it traveled since its shot time, sweeping so hits are still detected
+			if (Projectile != nullptr && Shot.TimeSinceShot > 0.0f)
+			{
+				const float Speed = Projectile->GetProjectileMovement()->InitialSpeed;
+				Projectile->SetActorLocation(Shot.Location + Shot.Rotation.Vector() * Speed * Shot.TimeSinceShot, true);
+			}
 		}
 	}
 	
-	// Try and play the sound if specified
+	// Try and play the sound if specified, once for all the shots of the frame
 	if (FireSound != nullptr)
 	{
 		UGameplayStatics::PlaySoundAtLocation(this, FireSound, Character->GetActorLocation());
@@ -66,6 +181,77 @@ void URPG_GameWeaponComponent::Fire()
 	}
 }
 
+void URPG_GameWeaponComponent::QueueHitscanShot(const FVector& MuzzleLocation, const FRotator& MuzzleRotation)
+{
+	UHitscanSubsystem* HitscanSubsystem = GetWorld()->GetSubsystem<UHitscanSubsystem>();
+	if (HitscanSubsystem == nullptr)
+	{
+		return;
+	}
+
+	FHitscanShot Shot;
+	Shot.Instigator = Character;
+	Shot.Start = MuzzleLocation;
+	Shot.Direction = FMath::VRandCone(MuzzleRotation.Vector(), FMath::DegreesToRadians(HitscanSpread));
+	Shot.Range = HitscanRange;
+	Shot.ImpulseSpeed = HitscanImpulseSpeed;
+	Shot.Damage = HitscanDamage;
+	Shot.MaxHits = HitscanMaxHits;
+	Shot.MaxPenetrationThickness = HitscanPenetrationThickness;
+	Shot.TraceChannel = HitscanChannel;
+
+	// The server resolves the shot against the world the client was seeing, with the same spread
+	if (!Character->HasAuthority())
+	{
+		Character->ServerFireHitscan(MuzzleLocation, Shot.Direction, Character->GetViewedServerTime());
+	}
+
+	HitscanSubsystem->QueueShot(Shot);
+}
+
+void URPG_GameWeaponComponent::QueueRemoteHitscanShot(const FVector& MuzzleLocation, const FVector& Direction, double ClientServerTime)
+{
+	UHitscanSubsystem* HitscanSubsystem = GetWorld()->GetSubsystem<UHitscanSubsystem>();
+	if (HitscanSubsystem == nullptr || Character == nullptr || FireMode != EWeaponFireMode::Hitscan)
+	{
+		return;
+	}
+
+	// A shot can't start further than the muzzle, with some slack for the movement corrections
+	if (FVector::DistSquared(MuzzleLocation, Character->GetActorLocation()) > FMath::Square(MuzzleOffset.Size() + RemoteMuzzleTolerance))
+	{
+		return;
+	}
+
+	// The client schedules its shots at RoundsPerMinute, the server earns one shot per interval and drops the early ones
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double ShotsPerSecond = FMath::Max(RoundsPerMinute, 1.0f) / 60.0;
+	RemoteShotCredit = FMath::Min(RemoteShotCredit + (Now - LastRemoteShotTime) * ShotsPerSecond, RemoteShotBurst);
+	LastRemoteShotTime = Now;
+	if (RemoteShotCredit < 1.0)
+	{
+		UE_LOG(RPGLog, Verbose, TEXT("Dropped an early hitscan shot of %s"), *GetNameSafe(Character));
+		return;
+	}
+	RemoteShotCredit -= 1.0;
+
+	FHitscanShot Shot;
+	Shot.Instigator = Character;
+	Shot.Start = MuzzleLocation;
+	Shot.Direction = Direction.GetSafeNormal();
+	Shot.Range = HitscanRange;
+	Shot.ImpulseSpeed = HitscanImpulseSpeed;
+	Shot.Damage = HitscanDamage;
+	Shot.MaxHits = HitscanMaxHits;
+	Shot.MaxPenetrationThickness = HitscanPenetrationThickness;
+	Shot.TraceChannel = HitscanChannel;
+
+	// The characters are rewound to the time seen by the client, never to the future of the server
+	Shot.RewindTime = FMath::Min(ClientServerTime, GetWorld()->GetTimeSeconds());
+
+	HitscanSubsystem->QueueShot(Shot);
+}
+
 bool URPG_GameWeaponComponent::AttachWeapon(ARPG_GameCharacter* TargetCharacter)
 {
 	Character = TargetCharacter;
@@ -91,8 +277,10 @@ bool URPG_GameWeaponComponent::AttachWeapon(ARPG_GameCharacter* TargetCharacter)
 
 		if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerController->InputComponent))
 		{
-			// Fire
-			EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Triggered, this, &URPG_GameWeaponComponent::Fire);
+			// Fire, the shots are scheduled at the rate of fire while the trigger is held
+			EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Started, this, &URPG_GameWeaponComponent::StartFiring);
+			EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Completed, this, &URPG_GameWeaponComponent::StopFiring);
+			EnhancedInputComponent->BindAction(FireAction, ETriggerEvent::Canceled, this, &URPG_GameWeaponComponent::StopFiring);
 		}
 	}
 
@@ -101,6 +289,8 @@ bool URPG_GameWeaponComponent::AttachWeapon(ARPG_GameCharacter* TargetCharacter)
 
 void URPG_GameWeaponComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	FireScheduler.StopFiring();
+
 	// ensure we have a character owner
 	if (Character != nullptr)
 	{
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Core/RPGEnums.h"
+#include "Combat/WeaponFireScheduler.h"
 #include "RPG_GameWeaponComponent.generated.h"
 
 class ARPG_GameCharacter;
@@ -14,10 +16,50 @@ class RPG_GAME_API URPG_GameWeaponComponent : public USkeletalMeshComponent
 	GENERATED_BODY()
 
 public:
+	/** Shots fired per minute while the trigger is held */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay, meta=(ClampMin = "1.0"))
+	float RoundsPerMinute = 600.0f;
+
+	/** If false, one shot is fired every time the trigger is pulled */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
+	bool bAutomatic = true;
+
+	/** How the shots of the weapon are resolved */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
+	EWeaponFireMode FireMode = EWeaponFireMode::Projectile;
+
 	/** Projectile class to spawn */
 	UPROPERTY(EditDefaultsOnly, Category=Projectile)
 	TSubclassOf<class ARPG_GameProjectile> ProjectileClass;
 
+	/** Maximum distance of a hitscan shot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "0.0", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanRange = 10000.0f;
+
+	/** Half angle in degrees of the cone where hitscan shots are spread */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "0.0", ClampMax = "45.0", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanSpread = 1.0f;
+
+	/** Maximum number of surfaces hit by a hitscan shot, including the penetrated ones */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "1", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	int32 HitscanMaxHits = 3;
+
+	/** Maximum thickness of a surface a hitscan shot can go through. 0 disables the penetration */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "0.0", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanPenetrationThickness = 10.0f;
+
+	/** Damage dealt to every actor hit by a hitscan shot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "0.0", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanDamage = 10.0f;
+
+	/** Speed of the equivalent projectile, used to compute the impulse of the hitscan shots */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(ClampMin = "0.0", EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	float HitscanImpulseSpeed = 3000.0f;
+
+	/** Collision channel of the hitscan traces */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Hitscan, meta=(EditCondition = "FireMode == EWeaponFireMode::Hitscan"))
+	TEnumAsByte<ECollisionChannel> HitscanChannel = ECC_Visibility;
+
 	/** Sound to play each time we fire */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category=Gameplay)
 	USoundBase* FireSound;
@@ -45,16 +87,67 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	bool AttachWeapon(ARPG_GameCharacter* TargetCharacter);
 
-	/** Make the weapon Fire a Projectile */
+	/** Make the weapon Fire a Projectile or a hitscan shot */
 	UFUNCTION(BlueprintCallable, Category="Weapon")
 	void Fire();
 
+	/** Pulls the trigger, the weapon fires at RoundsPerMinute until StopFiring is called */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void StartFiring();
+
+	/** Releases the trigger */
+	UFUNCTION(BlueprintCallable, Category="Weapon")
+	void StopFiring();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
 protected:
 	/** Ends gameplay for this component. */
 	UFUNCTION()
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	/** A shot fired during the frame */
+	struct FWeaponShot
+	{
+		FVector Location;
+		FRotator Rotation;
+		/** Time between the shot and the end of the frame */
+		float TimeSinceShot;
+	};
+
+	/** Computes the muzzle position from the camera of the holding character. Returns false without a player controller */
+	bool GetMuzzleTransform(FVector& OutLocation, FRotator& OutRotation) const;
+
+	/** Fires all the shots of a frame in a single batch */
+	void FireShots(TArrayView<const FWeaponShot> Shots);
+
+	/** Queues a hitscan shot to be resolved with the rest of the shots of the frame, and sends it to the server from a client */
+	void QueueHitscanShot(const FVector& MuzzleLocation, const FRotator& MuzzleRotation);
+
+public:
+	/**
+	 * Queues on the server a hitscan shot fired by the client controlling the character.
+	 *
+	 * @param MuzzleLocation Start of the shot on the client.
+	 * @param Direction Direction of the shot, with the spread applied by the client.
+	 * @param ClientServerTime Server time of the world the client was seeing when firing.
+	 */
+	void QueueRemoteHitscanShot(const FVector& MuzzleLocation, const FVector& Direction, double ClientServerTime);
+
+private:
+
 	/** The Character holding this weapon*/
 	ARPG_GameCharacter* Character;
+
+	/** Schedules the shots at the rate of fire */
+	FWeaponFireScheduler FireScheduler;
+
+	/** Shots the client may still send to the server at the rate of fire, and server time of the last one */
+	double RemoteShotCredit = 0.0;
+	double LastRemoteShotTime = -UE_BIG_NUMBER;
+
+	/** Muzzle position at the end of the previous frame, to interpolate the shots inside a frame */
+	FVector PreviousMuzzleLocation = FVector::ZeroVector;
+	FRotator PreviousMuzzleRotation = FRotator::ZeroRotator;
 };